@@ -0,0 +1,14 @@
+set(VENUS_BENCH_INC # include directories
+        "benchmark.h"
+        )
+
+set(VENUS_BENCH_SRC # source directories
+        ${VENUS_BENCH_INC}
+        "benchmark.cpp"
+        "benchMain.cpp"
+        "coreThreadBench.cpp"
+        "threadPoolBench.cpp"
+        "ioExecutorBench.cpp"
+        "eventBench.cpp"
+        "fibonacciHeapBench.cpp"
+        )
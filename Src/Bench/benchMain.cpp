@@ -0,0 +1,333 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <coreThread.h>
+#include <Events/eventDispatcher.h>
+#include <Threading/cpuTopology.h>
+#include <Threading/threadPool.h>
+#include <Threading/TaskScheduler/taskScheduler.h>
+
+namespace {
+    std::atomic<uint64_t> allocations{0};
+
+    /** Options given on the command line */
+    struct BenchOptions {
+        /** Only benchmarks whose name contains the filter are run, all of them if it is empty */
+        std::string filter;
+
+        /** File the results are written to as JSON, not written if empty */
+        std::string jsonPath;
+
+        /** Workers of every thread pool, 0 for one per CPU */
+        uint32_t workers{0};
+
+        /** Times each benchmark is run, the median run is reported */
+        uint32_t repetitions{1};
+    };
+
+    BenchOptions options;
+
+    /** The reported result of a benchmark */
+    struct BenchResult {
+        std::string name;
+        uint64_t iterations;
+        double nanosecondsPerOperation;
+        double allocationsPerOperation;
+
+        /** ns/op of every repetition, in the order they ran */
+        std::vector<double> repetitions;
+        std::map<std::string, double> counters;
+    };
+
+    void *countedAllocate(size_t size) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+
+        if (void *memory = std::malloc(size == 0 ? 1 : size))
+            return memory;
+
+        throw std::bad_alloc();
+    }
+
+    /**
+     * Parses a whole decimal count, without a sign or surrounding text
+     * @return False if the value is not a number or does not fit in 32 bits
+     */
+    bool parseCount(const char *value, uint32_t &count) {
+        if (*value < '0' || *value > '9')
+            return false;
+
+        char *end = nullptr;
+        errno = 0;
+        unsigned long long parsed = std::strtoull(value, &end, 10);
+
+        if (errno == ERANGE || *end != '\0' || parsed > std::numeric_limits<uint32_t>::max())
+            return false;
+
+        count = static_cast<uint32_t>(parsed);
+        return true;
+    }
+
+    /**
+     * Parses the command line, returns false if it is malformed
+     * @note Usage: Venus-Bench [filter] [--workers=N] [--repetitions=N] [--json=path]
+     */
+    bool parseOptions(int argc, char **argv) {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+
+            if (argument.rfind("--workers=", 0) == 0) {
+                if (!parseCount(argument.c_str() + std::strlen("--workers="), options.workers))
+                    return false;
+
+                continue;
+            }
+
+            if (argument.rfind("--repetitions=", 0) == 0) {
+                if (!parseCount(argument.c_str() + std::strlen("--repetitions="), options.repetitions) ||
+                    options.repetitions == 0)
+                    return false;
+
+                continue;
+            }
+
+            if (argument.rfind("--json=", 0) == 0) {
+                options.jsonPath = argument.substr(std::strlen("--json="));
+                continue;
+            }
+
+            if (argument.rfind("--", 0) == 0 || !options.filter.empty())
+                return false;
+
+            options.filter = argument;
+        }
+
+        return true;
+    }
+
+    /** Runs the benchmark the configured number of times, reporting the median run */
+    BenchResult runBenchmark(const Venus::Bench::Benchmark &benchmark) {
+        auto iterations = static_cast<double>(benchmark.iterations);
+
+        std::vector<std::pair<double, double>> runs;
+        std::map<std::string, double> counters;
+
+        for (uint32_t repetition = 0; repetition < options.repetitions; ++repetition) {
+            Venus::Bench::BenchmarkState state(benchmark.iterations);
+            benchmark.function(state);
+
+            runs.emplace_back(static_cast<double>(state.elapsed().count()) / iterations,
+                              static_cast<double>(state.allocations()) / iterations);
+            counters = state.counters();
+        }
+
+        BenchResult result{benchmark.name, benchmark.iterations, 0, 0, {}, std::move(counters)};
+        for (const auto &run : runs)
+            result.repetitions.push_back(run.first);
+
+        std::sort(runs.begin(), runs.end());
+        result.nanosecondsPerOperation = runs[runs.size() / 2].first;
+        result.allocationsPerOperation = runs[runs.size() / 2].second;
+
+        return result;
+    }
+
+    /** Runs every benchmark whose name contains the filter, an empty filter runs all of them */
+    std::vector<BenchResult> runBenchmarks() {
+        std::vector<BenchResult> results;
+        std::printf("%-48s %12s %14s %12s\n", "Benchmark", "Iterations", "ns/op", "allocs/op");
+
+        for (const auto &benchmark : Venus::Bench::BenchmarkRegistry::instance().benchmarks()) {
+            if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos)
+                continue;
+
+            const auto &result = results.emplace_back(runBenchmark(benchmark));
+
+            std::printf("%-48s %12llu %14.2f %12.2f", result.name.c_str(),
+                        static_cast<unsigned long long>(result.iterations), result.nanosecondsPerOperation,
+                        result.allocationsPerOperation);
+
+            for (const auto &[name, value] : result.counters)
+                std::printf("  %s=%.2f", name.c_str(), value);
+
+            std::printf("\n");
+            std::fflush(stdout);
+        }
+
+        return results;
+    }
+
+    /** Returns the value escaped for use inside a JSON string */
+    std::string escapeJson(const std::string &value) {
+        std::string escaped;
+        escaped.reserve(value.size());
+
+        for (char character : value) {
+            switch (character) {
+                case '"':
+                    escaped += "\\\"";
+                    break;
+                case '\\':
+                    escaped += "\\\\";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(character) < 0x20) {
+                        char code[7];
+                        std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(character));
+                        escaped += code;
+                    } else {
+                        escaped += character;
+                    }
+            }
+        }
+
+        return escaped;
+    }
+
+    /**
+     * Writes the results laid out like Google Benchmark's JSON output, so its tools can compare two runs
+     * @return False if the file could not be written
+     */
+    bool writeJson(const std::vector<BenchResult> &results, const char *executable) {
+        FILE *file = std::fopen(options.jsonPath.c_str(), "w");
+        if (file == nullptr)
+            return false;
+
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+        const auto &topology = Venus::Utility::Threading::CpuTopology::get();
+        uint32_t workers = options.workers != 0 ? options.workers : topology.getLogicalCpuCount();
+
+        std::fprintf(file, "{\n  \"context\": {\n");
+        std::fprintf(file, "    \"date\": \"%s\",\n", escapeJson(date).c_str());
+        std::fprintf(file, "    \"executable\": \"%s\",\n", escapeJson(executable).c_str());
+        std::fprintf(file, "    \"num_cpus\": %u,\n", topology.getLogicalCpuCount());
+        std::fprintf(file, "    \"num_cores\": %u,\n", topology.getCoreCount());
+        std::fprintf(file, "    \"workers\": %u,\n", workers);
+        std::fprintf(file, "    \"repetitions\": %u\n", options.repetitions);
+        std::fprintf(file, "  },\n  \"benchmarks\": [");
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto &result = results[i];
+
+            std::fprintf(file, "%s\n    {\n", i == 0 ? "" : ",");
+            std::fprintf(file, "      \"name\": \"%s\",\n", escapeJson(result.name).c_str());
+            std::fprintf(file, "      \"iterations\": %llu,\n", static_cast<unsigned long long>(result.iterations));
+            std::fprintf(file, "      \"real_time\": %.3f,\n", result.nanosecondsPerOperation);
+            std::fprintf(file, "      \"cpu_time\": %.3f,\n", result.nanosecondsPerOperation);
+            std::fprintf(file, "      \"time_unit\": \"ns\",\n");
+            std::fprintf(file, "      \"allocs_per_op\": %.3f,\n", result.allocationsPerOperation);
+
+            std::fprintf(file, "      \"repetition_times\": [");
+            for (size_t run = 0; run < result.repetitions.size(); ++run)
+                std::fprintf(file, "%s%.3f", run == 0 ? "" : ", ", result.repetitions[run]);
+            std::fprintf(file, "]");
+
+            // Counters sit next to the timings, as Google Benchmark reports them
+            for (const auto &[name, value] : result.counters)
+                std::fprintf(file, ",\n      \"%s\": %.3f", escapeJson(name).c_str(), value);
+
+            std::fprintf(file, "\n    }");
+        }
+
+        std::fprintf(file, "\n  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+}
+
+void *operator new(size_t size) {
+    return countedAllocate(size);
+}
+
+void *operator new[](size_t size) {
+    return countedAllocate(size);
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept {
+    std::free(memory);
+}
+
+namespace Venus::Bench {
+    uint64_t allocationCount() {
+        return allocations.load(std::memory_order_relaxed);
+    }
+
+    uint32_t workerCount() {
+        return options.workers;
+    }
+}
+
+/**
+ * Starts the engine's threading modules the same way VenusApplication does, the core thread runs on the main thread
+ * while the benchmarks run on a separate thread.
+ *
+ * Usage: Venus-Bench [filter] [--workers=N] [--repetitions=N] [--json=path]
+ *  --workers       Workers of every thread pool, spread over the CPUs by topology. Defaults to one per CPU
+ *  --repetitions   Times each benchmark is run, the median run is reported. Defaults to 1
+ *  --json          Also writes the results to the file as JSON, to track regressions between releases
+ */
+int main(int argc, char **argv) {
+    using namespace Venus::Utility::Threading;
+
+    if (!parseOptions(argc, argv)) {
+        std::fprintf(stderr, "Usage: %s [filter] [--workers=N] [--repetitions=N] [--json=path]\n", argv[0]);
+        return 1;
+    }
+
+    Venus::Core::CoreThread::ignite();
+
+    auto description = ThreadPoolDescription();
+    description.affinity = WorkerAffinity::Domain;
+    description.absoluteMaximum = options.workers;
+    Venus::Module<ThreadPool>::ignite(description);
+    Venus::Module<TaskScheduler>::ignite();
+    Venus::Utility::Events::EventDispatcher::ignite();
+
+    std::vector<BenchResult> results;
+
+    std::thread benchThread([&results]() {
+        results = runBenchmarks();
+        Venus::Core::CoreThread::shutDown();
+    });
+
+    Venus::Core::getCoreThread()->_go();
+    benchThread.join();
+
+    Venus::Utility::Events::EventDispatcher::shutDown();
+    TaskScheduler::shutDown();
+    ThreadPool::shutDown();
+
+    if (!options.jsonPath.empty() && !writeJson(results, argv[0])) {
+        std::fprintf(stderr, "Failed to write the results to %s\n", options.jsonPath.c_str());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "benchmark.h"
+
+namespace Venus::Bench {
+    BenchmarkState::BenchmarkState(uint64_t iterations)
+            : _iterations(iterations) {}
+
+    uint64_t BenchmarkState::iterations() const {
+        return this->_iterations;
+    }
+
+    void BenchmarkState::startTimer() {
+        this->_startAllocations = allocationCount();
+        this->_startTime = Clock::now();
+    }
+
+    void BenchmarkState::stopTimer() {
+        this->_elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - this->_startTime);
+        this->_allocations += allocationCount() - this->_startAllocations;
+    }
+
+    void BenchmarkState::setCounter(const std::string &name, double value) {
+        this->_counters[name] = value;
+    }
+
+    std::chrono::nanoseconds BenchmarkState::elapsed() const {
+        return this->_elapsed;
+    }
+
+    uint64_t BenchmarkState::allocations() const {
+        return this->_allocations;
+    }
+
+    const std::map<std::string, double> &BenchmarkState::counters() const {
+        return this->_counters;
+    }
+
+    BenchmarkRegistry &BenchmarkRegistry::instance() {
+        static BenchmarkRegistry registry;
+        return registry;
+    }
+
+    bool BenchmarkRegistry::add(std::string name, uint64_t iterations, BenchmarkFunction function) {
+        this->_benchmarks.push_back(Benchmark{std::move(name), iterations, std::move(function)});
+        return true;
+    }
+
+    const std::vector<Benchmark> &BenchmarkRegistry::benchmarks() const {
+        return this->_benchmarks;
+    }
+}
@@ -0,0 +1,111 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_BENCHMARK_H
+#define VENUS_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Venus::Bench {
+    /**
+     * State handed to a single benchmark run. The benchmark performs iterations() operations between startTimer()
+     * and stopTimer(), and may report additional counters alongside the timing.
+     */
+    class BenchmarkState {
+    public:
+        explicit BenchmarkState(uint64_t iterations);
+
+        /** Returns the number of operations the benchmark should perform */
+        [[nodiscard]] uint64_t iterations() const;
+
+        /** Starts timing the measured region, also snapshots the allocation count */
+        void startTimer();
+
+        /** Stops timing the measured region */
+        void stopTimer();
+
+        /**
+         * Records a named counter reported next to the timing
+         * @param name Name of the counter
+         * @param value Value of the counter
+         */
+        void setCounter(const std::string &name, double value);
+
+        /** Returns the time spent in the measured region */
+        [[nodiscard]] std::chrono::nanoseconds elapsed() const;
+
+        /** Returns the number of heap allocations made in the measured region */
+        [[nodiscard]] uint64_t allocations() const;
+
+        /** Returns the counters recorded by the benchmark */
+        [[nodiscard]] const std::map<std::string, double> &counters() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        uint64_t _iterations;
+        Clock::time_point _startTime{};
+        std::chrono::nanoseconds _elapsed{0};
+
+        uint64_t _startAllocations{0};
+        uint64_t _allocations{0};
+
+        std::map<std::string, double> _counters;
+    };
+
+    /** Signature of a benchmark body */
+    typedef std::function<void(BenchmarkState &)> BenchmarkFunction;
+
+    /** A registered benchmark */
+    struct Benchmark {
+        std::string name;
+        uint64_t iterations;
+        BenchmarkFunction function;
+    };
+
+    /** Holds every benchmark registered with VENUS_BENCHMARK */
+    class BenchmarkRegistry {
+    public:
+        /** Returns the global registry */
+        static BenchmarkRegistry &instance();
+
+        /**
+         * Registers a benchmark
+         * @param name Name the benchmark is reported and filtered under
+         * @param iterations Number of operations a single run performs
+         * @param function The benchmark body
+         * @return Always true, allows registration from a static initialiser
+         */
+        bool add(std::string name, uint64_t iterations, BenchmarkFunction function);
+
+        /** Returns the registered benchmarks */
+        [[nodiscard]] const std::vector<Benchmark> &benchmarks() const;
+
+    private:
+        std::vector<Benchmark> _benchmarks;
+    };
+
+    /** Returns the number of heap allocations made by the process so far */
+    uint64_t allocationCount();
+
+    /**
+     * Returns the number of workers the benchmarks' thread pools run, fixed with --workers so results are comparable
+     * across machines
+     * @return 0 for one worker per CPU, the pools' default
+     */
+    uint32_t workerCount();
+}
+
+/** Defines and registers a benchmark performing the given number of iterations */
+#define VENUS_BENCHMARK(name, iterations)                                                                          \
+    static void name(Venus::Bench::BenchmarkState &state);                                                         \
+    static const bool name##Registered = Venus::Bench::BenchmarkRegistry::instance().add(#name, iterations, name); \
+    static void name(Venus::Bench::BenchmarkState &state)
+
+#endif //VENUS_BENCHMARK_H
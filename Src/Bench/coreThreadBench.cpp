@@ -0,0 +1,351 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "benchmark.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <coreThread.h>
+
+using namespace Venus::Core;
+
+namespace {
+    constexpr uint64_t COMMAND_ITERATIONS = 100000;
+
+    /** Commands waited on one at a time by the round trip benchmarks */
+    constexpr uint64_t ROUND_TRIP_ITERATIONS = 20000;
+
+    /** Packet counterpart of the closures used by the benchmarks below */
+    struct CountPacket {
+        static constexpr CommandOpcode Opcode = 1;
+        std::atomic<uint64_t> *executed;
+
+        static void execute(const CountPacket &packet) {
+            packet.executed->fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    /** Busy waits for the given duration, standing in for per-frame simulation or render work */
+    void simulateWork(std::chrono::microseconds duration) {
+        auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end);
+    }
+
+    /** Blocks until every command queued on the internal queue so far has executed */
+    void drainInternalQueue() {
+        getCoreThread()->queueCommand([]() {}, CTQF_InternalQueue | CTQF_BlockUntilComplete);
+    }
+}
+
+VENUS_BENCHMARK(CoreThread_InternalQueue_StdFunction, COMMAND_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    std::atomic<uint64_t> executed{0};
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        std::function<void()> command = [&executed]() { executed.fetch_add(1, std::memory_order_relaxed); };
+        coreThread->queueCommand(std::move(command), CTQF_InternalQueue);
+    }
+    drainInternalQueue();
+    state.stopTimer();
+}
+
+VENUS_BENCHMARK(CoreThread_InternalQueue_Lambda, COMMAND_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    std::atomic<uint64_t> executed{0};
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+        coreThread->queueCommand([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); },
+                                 CTQF_InternalQueue);
+    drainInternalQueue();
+    state.stopTimer();
+}
+
+VENUS_BENCHMARK(CoreThread_InternalQueue_DiscardResult, COMMAND_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    std::atomic<uint64_t> executed{0};
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+        coreThread->queueCommand(DiscardResult, [&executed]() { executed.fetch_add(1, std::memory_order_relaxed); },
+                                 CTQF_InternalQueue);
+    drainInternalQueue();
+    state.stopTimer();
+}
+
+VENUS_BENCHMARK(CoreThread_InternalQueue_DiscardResultOversized, COMMAND_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    std::atomic<uint64_t> executed{0};
+    std::array<uint64_t, 8> payload{};
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+        coreThread->queueCommand(DiscardResult, [&executed, payload]() {
+            executed.fetch_add(payload[0] + 1, std::memory_order_relaxed);
+        }, CTQF_InternalQueue);
+    drainInternalQueue();
+    state.stopTimer();
+}
+
+VENUS_BENCHMARK(CoreThread_InternalQueue_ReturningGeneric, COMMAND_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    std::vector<std::shared_ptr<AsyncResult>> results;
+    results.reserve(state.iterations());
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+        results.push_back(coreThread->queueReturningCommand([i]() { return Venus::GenericObject(i); }, CTQF_InternalQueue));
+    drainInternalQueue();
+
+    uint64_t sum = 0;
+    for (auto &result : results)
+        sum += result->getTaskResultObject().getValue<uint64_t>();
+    state.stopTimer();
+
+    state.setCounter("sum", static_cast<double>(sum));
+}
+
+VENUS_BENCHMARK(CoreThread_InternalQueue_ReturningTyped, COMMAND_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    std::vector<std::shared_ptr<TypedAsyncResult<uint64_t>>> results;
+    results.reserve(state.iterations());
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+        results.push_back(coreThread->queueReturningCommand<uint64_t>([i]() { return i; }, CTQF_InternalQueue));
+    drainInternalQueue();
+
+    uint64_t sum = 0;
+    for (auto &result : results)
+        sum += result->getResult();
+    state.stopTimer();
+
+    state.setCounter("sum", static_cast<double>(sum));
+}
+
+VENUS_BENCHMARK(CoreThread_ThreadQueue_DiscardResult, COMMAND_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    std::atomic<uint64_t> executed{0};
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+        coreThread->queueCommand(DiscardResult, [&executed]() { executed.fetch_add(1, std::memory_order_relaxed); });
+    coreThread->submit();
+    drainInternalQueue();
+    state.stopTimer();
+}
+
+VENUS_BENCHMARK(CoreThread_ThreadQueue_SubmitPerCommand, COMMAND_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    std::atomic<uint64_t> executed{0};
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        coreThread->queueCommand(DiscardResult, [&executed]() { executed.fetch_add(1, std::memory_order_relaxed); });
+        coreThread->submit();
+    }
+    drainInternalQueue();
+    state.stopTimer();
+}
+
+VENUS_BENCHMARK(CoreThread_ThreadQueue_Packet, COMMAND_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    std::atomic<uint64_t> executed{0};
+    CommandPacketTable::registerPacket<CountPacket>();
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+        coreThread->queuePacket(CountPacket{&executed});
+    coreThread->submit();
+    drainInternalQueue();
+    state.stopTimer();
+}
+
+/**
+ * Measures the time from queueing a command on the internal queue to it starting to execute. Commands are issued one
+ * at a time with gaps of up to 200us in between, so both a spinning and a parked core thread are exercised.
+ */
+VENUS_BENCHMARK(CoreThread_InternalQueue_Latency, 2000) {
+    using Clock = std::chrono::steady_clock;
+
+    auto coreThread = getCoreThread();
+    std::vector<int64_t> latencies(state.iterations());
+    std::atomic<uint64_t> executed{0};
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        auto queuedAt = Clock::now();
+
+        coreThread->queueCommand(DiscardResult, [&latencies, &executed, queuedAt, i]() {
+            latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - queuedAt).count();
+            executed.store(i + 1, std::memory_order_release);
+        }, CTQF_InternalQueue);
+
+        while (executed.load(std::memory_order_acquire) != i + 1)
+            std::this_thread::yield();
+
+        std::this_thread::sleep_for(std::chrono::microseconds((i * 37) % 200));
+    }
+    state.stopTimer();
+
+    std::sort(latencies.begin(), latencies.end());
+    state.setCounter("p50_ns", static_cast<double>(latencies[latencies.size() / 2]));
+    state.setCounter("p99_ns", static_cast<double>(latencies[latencies.size() * 99 / 100]));
+}
+
+/** A command queued on the internal queue and waited on, one at a time */
+VENUS_BENCHMARK(CoreThread_InternalQueue_RoundTrip, ROUND_TRIP_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    uint64_t executed = 0;
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+        coreThread->queueCommand([&executed]() { ++executed; }, CTQF_InternalQueue | CTQF_BlockUntilComplete);
+    state.stopTimer();
+
+    state.setCounter("executed", static_cast<double>(executed));
+}
+
+/** A command recorded on the thread's queue, submitted and waited on, one at a time */
+VENUS_BENCHMARK(CoreThread_ThreadQueue_SubmitRoundTrip, ROUND_TRIP_ITERATIONS) {
+    auto coreThread = getCoreThread();
+    std::atomic<uint64_t> executed{0};
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        coreThread->queueCommand(DiscardResult, [&executed]() { executed.fetch_add(1, std::memory_order_release); });
+        coreThread->submit();
+
+        while (executed.load(std::memory_order_acquire) != i + 1)
+            std::this_thread::yield();
+    }
+    state.stopTimer();
+}
+
+/** 100us of application work per frame followed by a blocking 100us core thread update, the pre pipeline behaviour */
+VENUS_BENCHMARK(CoreThread_Frames_Serialized, 500) {
+    auto coreThread = getCoreThread();
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        simulateWork(std::chrono::microseconds(100));
+        coreThread->queueCommand([]() { simulateWork(std::chrono::microseconds(100)); },
+                                 CTQF_InternalQueue | CTQF_BlockUntilComplete);
+    }
+    state.stopTimer();
+}
+
+/** The same frames submitted through the frame pipeline, so application and core thread work overlap */
+VENUS_BENCHMARK(CoreThread_Frames_Pipelined, 500) {
+    auto coreThread = getCoreThread();
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        simulateWork(std::chrono::microseconds(100));
+        coreThread->queueCommand(DiscardResult, []() { simulateWork(std::chrono::microseconds(100)); });
+        coreThread->submitFrame();
+    }
+    coreThread->waitForFrames();
+    state.stopTimer();
+}
+
+/**
+ * Measures how long a realtime command waits when it is queued behind 100 background commands of 10us each. Without
+ * priority lanes it would wait for the whole millisecond of background work.
+ */
+VENUS_BENCHMARK(CoreThread_Lanes_RealtimeBehindBackground, 200) {
+    using Clock = std::chrono::steady_clock;
+
+    auto coreThread = getCoreThread();
+    std::vector<int64_t> latencies(state.iterations());
+    drainInternalQueue();
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        for (uint32_t j = 0; j < 100; ++j)
+            coreThread->queueCommand(DiscardResult, []() { simulateWork(std::chrono::microseconds(10)); },
+                                     CTQF_InternalQueue | CTQF_Background);
+
+        auto queuedAt = Clock::now();
+        coreThread->queueCommand(DiscardResult, [&latencies, queuedAt, i]() {
+            latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - queuedAt).count();
+        }, CTQF_InternalQueue | CTQF_Realtime);
+
+        getCoreThread()->queueCommand([]() {}, CTQF_InternalQueue | CTQF_Background | CTQF_BlockUntilComplete);
+    }
+    state.stopTimer();
+
+    std::sort(latencies.begin(), latencies.end());
+    state.setCounter("p50_ns", static_cast<double>(latencies[latencies.size() / 2]));
+    state.setCounter("p99_ns", static_cast<double>(latencies[latencies.size() * 99 / 100]));
+}
+
+namespace {
+    /**
+     * Submits a 10ms buffer of 200 commands of 50us each, the first of which queues a realtime command, and measures
+     * how long the realtime command waits. Without a playback budget it waits for the rest of the buffer.
+     */
+    void realtimeBehindLargeBuffer(Venus::Bench::BenchmarkState &state, std::chrono::microseconds budget) {
+        using Clock = std::chrono::steady_clock;
+
+        auto coreThread = getCoreThread();
+        auto previousBudget = coreThread->getPlaybackBudget();
+        std::vector<int64_t> latencies(state.iterations());
+        coreThread->setPlaybackBudget(budget);
+
+        // The budget is picked up by the core thread's next iteration, let it go idle so one starts
+        drainInternalQueue();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        state.startTimer();
+        for (uint64_t i = 0; i < state.iterations(); ++i) {
+            coreThread->queueCommand(DiscardResult, [coreThread, &latencies, i]() {
+                auto queuedAt = Clock::now();
+
+                coreThread->queueCommand(DiscardResult, [&latencies, queuedAt, i]() {
+                    latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - queuedAt).count();
+                }, CTQF_InternalQueue | CTQF_Realtime);
+            });
+
+            for (uint32_t j = 0; j < 200; ++j)
+                coreThread->queueCommand(DiscardResult, []() { simulateWork(std::chrono::microseconds(50)); });
+
+            coreThread->submit();
+            drainInternalQueue();
+        }
+        state.stopTimer();
+
+        coreThread->setPlaybackBudget(previousBudget);
+
+        std::sort(latencies.begin(), latencies.end());
+        state.setCounter("p50_ns", static_cast<double>(latencies[latencies.size() / 2]));
+        state.setCounter("p99_ns", static_cast<double>(latencies[latencies.size() * 99 / 100]));
+    }
+}
+
+VENUS_BENCHMARK(CoreThread_Budget_RealtimeBehindLargeBuffer_Unlimited, 50) {
+    realtimeBehindLargeBuffer(state, std::chrono::microseconds(0));
+}
+
+VENUS_BENCHMARK(CoreThread_Budget_RealtimeBehindLargeBuffer_Budgeted, 50) {
+    realtimeBehindLargeBuffer(state, CORE_THREAD_DEFAULT_PLAYBACK_BUDGET);
+}
@@ -0,0 +1,52 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "benchmark.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <Events/event.h>
+
+using namespace Venus::Utility::Events;
+
+namespace {
+    /** Notifications sent by each benchmark, every one reaching each of the subscribers */
+    constexpr uint64_t NOTIFY_ITERATIONS = 2000;
+    constexpr uint32_t EVENT_SUBSCRIBERS = 64;
+
+    /** Notifies an event with EVENT_SUBSCRIBERS subscribers, waiting for every invocation to run */
+    void runNotifyAll(Venus::Bench::BenchmarkState &state, EventExecutionFlag executionFlag) {
+        Event<std::function<void()>> event(executionFlag);
+        std::atomic<uint64_t> invoked{0};
+
+        for (uint32_t i = 0; i < EVENT_SUBSCRIBERS; ++i)
+            event.subscribe([&invoked]() { invoked.fetch_add(1, std::memory_order_release); });
+
+        uint64_t expected = state.iterations() * EVENT_SUBSCRIBERS;
+
+        state.startTimer();
+        for (uint64_t i = 0; i < state.iterations(); ++i)
+            event.notifyAll();
+
+        // Sleeps rather than yields, the workers and core thread would otherwise compete with this thread
+        while (invoked.load(std::memory_order_acquire) < expected)
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        state.stopTimer();
+
+        state.setCounter("invocations", static_cast<double>(invoked.load()));
+    }
+}
+
+VENUS_BENCHMARK(Event_NotifyAll_Caller, NOTIFY_ITERATIONS) {
+    runNotifyAll(state, EventExecutionFlag::EEF_Caller);
+}
+
+VENUS_BENCHMARK(Event_NotifyAll_ThreadPool, NOTIFY_ITERATIONS) {
+    runNotifyAll(state, EventExecutionFlag::EEF_Default);
+}
+
+VENUS_BENCHMARK(Event_NotifyAll_CoreThread, NOTIFY_ITERATIONS) {
+    runNotifyAll(state, EventExecutionFlag::EEF_CoreThreadQueue);
+}
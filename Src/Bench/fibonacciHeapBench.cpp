@@ -0,0 +1,116 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "benchmark.h"
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+#include <Datastructures/fibonacciHeap.h>
+
+using namespace Venus::Utility::DataStructures;
+
+namespace {
+    /** Elements pushed and popped by each benchmark */
+    constexpr uint64_t HEAP_ITERATIONS = 100000;
+
+    /** Returns the given number of pseudo random keys, the same keys on every call */
+    std::vector<float> createKeys(uint64_t count) {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> distribution(0.0f, 1000000.0f);
+        std::vector<float> keys(count);
+
+        for (auto &key : keys)
+            key = distribution(generator);
+
+        return keys;
+    }
+
+    /** Pops every element, returning 1 if they came out in ascending order of key and 0 otherwise */
+    double popAllInOrder(FibonacciHeap<const float *> &heap) {
+        float previous = -1.0f;
+        double ordered = 1;
+
+        while (heap.size() > 0) {
+            float key = *heap.getMinimum();
+            if (key < previous)
+                ordered = 0;
+
+            previous = key;
+            heap.popMinimum();
+        }
+
+        return ordered;
+    }
+}
+
+VENUS_BENCHMARK(FibonacciHeap_InsertPopMinimum, HEAP_ITERATIONS) {
+    auto keys = createKeys(state.iterations());
+    FibonacciHeap<const float *> heap;
+
+    state.startTimer();
+    for (const auto &key : keys)
+        heap.insert(&key, key);
+
+    double ordered = popAllInOrder(heap);
+    state.stopTimer();
+
+    state.setCounter("ordered", ordered);
+}
+
+/** Every element's key is decreased once before the heap is drained, the keys the elements point at follow */
+VENUS_BENCHMARK(FibonacciHeap_DecreaseKey, HEAP_ITERATIONS) {
+    auto keys = createKeys(state.iterations());
+    FibonacciHeap<const float *> heap;
+
+    std::vector<FibHeapNode<const float *> *> nodes;
+    nodes.reserve(keys.size());
+
+    for (const auto &key : keys)
+        nodes.push_back(heap.insert(&key, key));
+
+    // Consolidated by a pop first, decreasing keys in a heap of single nodes never cuts
+    float smallest = *heap.getMinimum();
+    heap.popMinimum();
+
+    state.startTimer();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] == smallest)
+            continue;
+
+        keys[i] /= 2;
+        heap.updateKey(nodes[i], keys[i]);
+    }
+
+    double ordered = popAllInOrder(heap);
+    state.stopTimer();
+
+    state.setCounter("ordered", ordered);
+}
+
+/** The standard library's binary heap, for scale */
+VENUS_BENCHMARK(StdPriorityQueue_PushPop, HEAP_ITERATIONS) {
+    auto keys = createKeys(state.iterations());
+    std::priority_queue<std::pair<float, const float *>, std::vector<std::pair<float, const float *>>,
+            std::greater<>> queue;
+
+    state.startTimer();
+    for (const auto &key : keys)
+        queue.emplace(key, &key);
+
+    float previous = -1.0f;
+    double ordered = 1;
+
+    while (!queue.empty()) {
+        if (queue.top().first < previous)
+            ordered = 0;
+
+        previous = queue.top().first;
+        queue.pop();
+    }
+    state.stopTimer();
+
+    state.setCounter("ordered", ordered);
+}
@@ -0,0 +1,85 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "benchmark.h"
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <Threading/ioExecutor.h>
+
+using namespace Venus::Utility::Threading;
+
+namespace {
+    constexpr uint64_t READ_ITERATIONS = 20000;
+
+    /** Size of each read and of the file read from */
+    constexpr uint32_t READ_SIZE = 4096;
+    constexpr uint32_t READ_FILE_SIZE = 4 * 1024 * 1024;
+
+    /** Number of reads in flight at once */
+    constexpr uint32_t READ_BATCH = 64;
+
+    /** Writes the file the benchmarks read from, returning its path */
+    std::string createReadFile() {
+        std::string path = "venus_bench_io.dat";
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        std::vector<char> block(READ_SIZE);
+        for (uint32_t offset = 0; offset < READ_FILE_SIZE; offset += READ_SIZE) {
+            for (uint32_t i = 0; i < READ_SIZE; ++i)
+                block[i] = static_cast<char>((offset + i) % 251);
+
+            file.write(block.data(), READ_SIZE);
+        }
+
+        return path;
+    }
+
+    /** Reads the file in batches through an executor of its own, the file's pages are cached by the first pass */
+    void runReads(Venus::Bench::BenchmarkState &state, bool enableIoUring) {
+        auto description = IoExecutorDescription();
+        description.enableIoUring = enableIoUring;
+
+        auto executor = std::make_shared<IoExecutor>(description);
+        executor->ignition();
+
+        std::string path = createReadFile();
+        std::vector<std::shared_ptr<TypedAsyncResult<IoBuffer>>> reads;
+        uint64_t failed = 0;
+
+        state.startTimer();
+        for (uint64_t done = 0; done < state.iterations(); done += reads.size()) {
+            reads.clear();
+
+            for (uint64_t i = done; i < state.iterations() && reads.size() < READ_BATCH; ++i) {
+                uint64_t offset = i * READ_SIZE % READ_FILE_SIZE;
+                reads.push_back(executor->read(path, offset, READ_SIZE));
+            }
+
+            for (const auto &read : reads) {
+                read->blockUntilComplete();
+                failed += read->getResult().data.size() != READ_SIZE;
+            }
+        }
+        state.stopTimer();
+
+        executor->shutdown();
+        std::remove(path.c_str());
+
+        state.setCounter("io_uring", executor->isUsingIoUring() ? 1 : 0);
+        state.setCounter("failed", static_cast<double>(failed));
+    }
+}
+
+/** Reads submitted to an io_uring serviced by a single I/O thread */
+VENUS_BENCHMARK(IoExecutor_Read4K_IoUring, READ_ITERATIONS) {
+    runReads(state, true);
+}
+
+/** Reads run with pread on the blocking I/O threads */
+VENUS_BENCHMARK(IoExecutor_Read4K_BlockingThreads, READ_ITERATIONS) {
+    runReads(state, false);
+}
@@ -0,0 +1,601 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include <Threading/threadPool.h>
+#include <Threading/parallel.h>
+#include <Threading/trace.h>
+#include <Threading/TaskScheduler/taskScheduler.h>
+#include <Threading/TaskScheduler/taskGraph.h>
+#include <Datastructures/priorityBucketQueue.h>
+
+using namespace Venus::Utility::Threading;
+
+namespace {
+    constexpr uint64_t POOL_ITERATIONS = 50000;
+
+    /** Number of tasks each task queues from inside the pool in the nested benchmarks */
+    constexpr uint64_t NESTED_FAN_OUT = 4;
+
+    /** Queued task counts of the worker queue benchmarks, sorting on every push cannot get through 100k in time */
+    constexpr uint64_t BUCKET_QUEUE_ITERATIONS = 100000;
+    constexpr uint64_t SORTED_QUEUE_ITERATIONS = 2000;
+
+    /** Tasks of the blocking work benchmarks, each sleeping as if waiting on I/O */
+    constexpr uint64_t BLOCKING_ITERATIONS = 256;
+    constexpr std::chrono::milliseconds BLOCKING_TASK_DURATION{2};
+
+    /** Chunks of the streaming benchmarks, the cancelled run drops the stream once a quarter has been processed */
+    constexpr uint64_t STREAMING_ITERATIONS = 4096;
+    constexpr uint32_t STREAMING_CHUNK_ROUNDS = 20000;
+
+    /** Events recorded by the tracing benchmarks, several times a thread's buffer so it wraps */
+    constexpr uint64_t TRACE_ITERATIONS = 1 << 18;
+
+    /** Number of elements the data parallel benchmarks loop over */
+    constexpr uint64_t PARALLEL_ITERATIONS = 1 << 20;
+
+    /** Shape of the task trees run by the scheduler benchmarks, each tree holds 1365 tasks */
+    constexpr uint32_t TASK_TREE_DEPTH = 5;
+    constexpr uint32_t TASK_TREE_FAN_OUT = 4;
+    constexpr uint64_t TASK_TREE_ITERATIONS = 20;
+
+    /** Tasks added one at a time by the scheduling latency benchmark */
+    constexpr uint64_t ADD_TASK_ITERATIONS = 5000;
+
+    /** Groups run by the fan out benchmark, each of its tasks feeding a single task depending on the whole group */
+    constexpr uint64_t GROUP_ITERATIONS = 500;
+    constexpr uint32_t GROUP_FAN_OUT = 64;
+
+    /** Shape of the frame graph benchmarks, layers of nodes each depending on two nodes of the layer before */
+    constexpr uint32_t FRAME_GRAPH_LAYERS = 10;
+    constexpr uint32_t FRAME_GRAPH_WIDTH = 50;
+    constexpr uint64_t FRAME_GRAPH_ITERATIONS = 200;
+
+    /** Returns the given number of pseudo random values, the same values on every call */
+    std::vector<uint32_t> createRandomValues(uint64_t count) {
+        std::mt19937 generator(42);
+        std::vector<uint32_t> values(count);
+
+        for (auto &value : values)
+            value = generator();
+
+        return values;
+    }
+
+    /** Creates tasks cycling through every priority, each task's id is its creation order */
+    std::vector<std::shared_ptr<Task>> createTasks(uint64_t count) {
+        std::vector<std::shared_ptr<Task>> tasks;
+        tasks.reserve(count);
+
+        for (uint64_t i = 0; i < count; ++i) {
+            auto description = TaskDescription();
+            description.TaskId = static_cast<uint32_t>(i);
+            description.Priority = static_cast<TaskPriority>(
+                    static_cast<uint32_t>(TaskPriority::VeryLow) + (i * 7) % TASK_PRIORITY_LEVELS);
+
+            tasks.push_back(std::make_shared<Task>(description));
+        }
+
+        return tasks;
+    }
+
+    /** Returns 1 if the tasks come out highest priority first and in creation order within a priority, 0 otherwise */
+    double isPriorityOrdered(const std::vector<std::shared_ptr<Task>> &popped) {
+        for (size_t i = 1; i < popped.size(); ++i) {
+            auto previous = getTaskPriorityLevel(popped[i - 1]->getPriority());
+            auto current = getTaskPriorityLevel(popped[i]->getPriority());
+
+            if (previous < current || (previous == current && popped[i - 1]->getTaskId() > popped[i]->getTaskId()))
+                return 0;
+        }
+
+        return 1;
+    }
+
+    /** Creates a pool separate from the engine's, so both scheduling modes can be measured in one run */
+    std::shared_ptr<ThreadPool> createPool(bool enableWorkStealing) {
+        auto description = ThreadPoolDescription();
+        description.enableWorkStealing = enableWorkStealing;
+        description.absoluteMaximum = Venus::Bench::workerCount();
+
+        return std::make_shared<ThreadPool>(description);
+    }
+
+    /**
+     * Waits until the counter reaches the expected value
+     * @note Sleeps rather than yields, the benchmark thread inherits the core thread's real time priority and would
+     * otherwise starve the workers on machines with few cores
+     */
+    void waitForCount(const std::atomic<uint64_t> &counter, uint64_t expected) {
+        while (counter.load(std::memory_order_acquire) < expected)
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    /** Adds a child task for every branch to the scheduler and waits on each of them, down to the leaves */
+    void runTaskTree(TaskScheduler &scheduler, uint32_t depth, std::atomic<uint64_t> &leaves) {
+        if (depth == 0) {
+            leaves.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::vector<std::shared_ptr<Task>> children;
+        children.reserve(TASK_TREE_FAN_OUT);
+
+        for (uint32_t branch = 0; branch < TASK_TREE_FAN_OUT; ++branch) {
+            auto description = TaskDescription();
+            description.Work = [&scheduler, depth, &leaves]() { runTaskTree(scheduler, depth - 1, leaves); };
+
+            children.push_back(std::make_shared<Task>(description));
+            scheduler.addTask(children.back());
+        }
+
+        for (const auto &child : children)
+            child->wait();
+    }
+
+    /** Runs task trees on a scheduler separate from the engine's, with or without fibers */
+    void runTaskTrees(Venus::Bench::BenchmarkState &state, bool enableFibers) {
+        auto description = TaskSchedulerDescription();
+        description.enableFibers = enableFibers;
+
+        auto scheduler = std::make_shared<TaskScheduler>(description);
+        scheduler->ignition();
+
+        std::atomic<uint64_t> leaves{0};
+
+        state.startTimer();
+        for (uint64_t i = 0; i < state.iterations(); ++i) {
+            auto root = TaskDescription();
+            root.Work = [&scheduler, &leaves]() { runTaskTree(*scheduler, TASK_TREE_DEPTH, leaves); };
+
+            auto task = std::make_shared<Task>(root);
+            scheduler->addTask(task);
+            task->wait();
+        }
+        state.stopTimer();
+
+        scheduler->shutdown();
+        state.setCounter("leaves", static_cast<double>(leaves.load()));
+    }
+
+    /** Results of the frame graph nodes, one per node in layer order */
+    using FrameValues = std::vector<uint64_t>;
+
+    /** Runs a frame graph node, folding the results of the two nodes it depends on into its own */
+    void runFrameNode(FrameValues &values, uint32_t layer, uint32_t column) {
+        uint64_t value = layer;
+
+        if (layer > 0) {
+            const uint64_t *previous = &values[(layer - 1) * FRAME_GRAPH_WIDTH];
+            value += previous[column] + previous[(column + 1) % FRAME_GRAPH_WIDTH];
+        }
+
+        // A little work per node, a frame's systems do more than add two numbers
+        for (uint32_t i = 0; i < 256; ++i)
+            value = value * 6364136223846793005ull + 1442695040888963407ull;
+
+        values[layer * FRAME_GRAPH_WIDTH + column] = value;
+    }
+
+    /** Returns 1 if the values match those of the frame graph run on a single thread, 0 otherwise */
+    double isFrameCorrect(const FrameValues &values) {
+        FrameValues expected(values.size());
+
+        for (uint32_t layer = 0; layer < FRAME_GRAPH_LAYERS; ++layer) {
+            for (uint32_t column = 0; column < FRAME_GRAPH_WIDTH; ++column)
+                runFrameNode(expected, layer, column);
+        }
+
+        return values == expected ? 1 : 0;
+    }
+
+    /** Queues every task from the benchmark thread */
+    void queueFromOutside(Venus::Bench::BenchmarkState &state, bool enableWorkStealing) {
+        auto pool = createPool(enableWorkStealing);
+        std::atomic<uint64_t> executed{0};
+
+        state.startTimer();
+        for (uint64_t i = 0; i < state.iterations(); ++i)
+            pool->queueWork([&executed]() { executed.fetch_add(1, std::memory_order_release); });
+
+        waitForCount(executed, state.iterations());
+        state.stopTimer();
+
+        pool->shutdown();
+    }
+
+    /** Queues a fraction of the tasks from the benchmark thread, each of which queues the rest from inside the pool */
+    void queueFromInside(Venus::Bench::BenchmarkState &state, bool enableWorkStealing) {
+        auto pool = createPool(enableWorkStealing);
+        std::atomic<uint64_t> executed{0};
+        uint64_t roots = state.iterations() / (NESTED_FAN_OUT + 1);
+
+        state.startTimer();
+        for (uint64_t i = 0; i < roots; ++i) {
+            pool->queueWork([&executed, &pool]() {
+                for (uint64_t child = 0; child < NESTED_FAN_OUT; ++child)
+                    pool->queueWork([&executed]() { executed.fetch_add(1, std::memory_order_release); });
+
+                executed.fetch_add(1, std::memory_order_release);
+            });
+        }
+
+        waitForCount(executed, roots * (NESTED_FAN_OUT + 1));
+        state.stopTimer();
+
+        pool->shutdown();
+    }
+
+    /** Queues tasks that block their worker, from inside the pool so they land on the workers' deques */
+    void runBlockingWork(Venus::Bench::BenchmarkState &state, bool enableElasticScaling) {
+        auto description = ThreadPoolDescription();
+        description.enableElasticScaling = enableElasticScaling;
+        description.absoluteMaximum = Venus::Bench::workerCount();
+
+        auto pool = std::make_shared<ThreadPool>(description);
+        std::atomic<uint64_t> executed{0};
+
+        state.startTimer();
+        pool->queueWork([&]() {
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                pool->queueWork([&executed]() {
+                    std::this_thread::sleep_for(BLOCKING_TASK_DURATION);
+                    executed.fetch_add(1, std::memory_order_release);
+                });
+            }
+        });
+
+        waitForCount(executed, state.iterations());
+        state.stopTimer();
+
+        state.setCounter("workers", pool->getWorkerQuota());
+        pool->shutdown();
+    }
+
+    /**
+     * Queues a stream of chunks, as a streaming load would, optionally cancelling the stream part way through
+     * @note The chunks poll the token too, a chunk already running when the stream is cancelled stops early
+     */
+    void runStreamingWork(Venus::Bench::BenchmarkState &state, bool cancelPartWay) {
+        auto pool = createPool(true);
+        CancellationSource stream;
+        CancellationToken token = stream.getToken();
+
+        std::atomic<uint64_t> processed{0};
+        std::vector<std::shared_ptr<PooledWorkDescription>> chunks;
+        chunks.reserve(state.iterations());
+
+        state.startTimer();
+        for (uint64_t i = 0; i < state.iterations(); ++i) {
+            chunks.push_back(pool->queueWork([&processed, token]() {
+                uint64_t value = 0;
+                for (uint32_t round = 0; round < STREAMING_CHUNK_ROUNDS && !token.isCancellationRequested(); ++round)
+                    value = value * 6364136223846793005ull + 1442695040888963407ull;
+
+                processed.fetch_add(value != 0 ? 1 : 0, std::memory_order_release);
+            }, token));
+        }
+
+        if (cancelPartWay) {
+            waitForCount(processed, state.iterations() / 4);
+            stream.cancel();
+        }
+
+        for (const auto &chunk : chunks)
+            chunk->waitTillComplete();
+        state.stopTimer();
+
+        state.setCounter("processed", static_cast<double>(processed.load()));
+        pool->shutdown();
+    }
+}
+
+VENUS_BENCHMARK(ThreadPool_QueueWork_LeastBusy, POOL_ITERATIONS) {
+    queueFromOutside(state, false);
+}
+
+VENUS_BENCHMARK(ThreadPool_QueueWork_WorkStealing, POOL_ITERATIONS) {
+    queueFromOutside(state, true);
+}
+
+VENUS_BENCHMARK(ThreadPool_NestedWork_LeastBusy, POOL_ITERATIONS) {
+    queueFromInside(state, false);
+}
+
+VENUS_BENCHMARK(ThreadPool_NestedWork_WorkStealing, POOL_ITERATIONS) {
+    queueFromInside(state, true);
+}
+
+/** Blocked workers are left to sit on the queued work */
+VENUS_BENCHMARK(ThreadPool_BlockingWork_FixedWorkers, BLOCKING_ITERATIONS) {
+    runBlockingWork(state, false);
+}
+
+/** The elastic controller adds temporary workers while the workers are blocked */
+VENUS_BENCHMARK(ThreadPool_BlockingWork_ElasticWorkers, BLOCKING_ITERATIONS) {
+    runBlockingWork(state, true);
+}
+
+VENUS_BENCHMARK(ThreadPool_StreamingWork_RunToEnd, STREAMING_ITERATIONS) {
+    runStreamingWork(state, false);
+}
+
+/** The chunks still queued when the stream is cancelled are skipped by the workers */
+VENUS_BENCHMARK(ThreadPool_StreamingWork_Cancelled, STREAMING_ITERATIONS) {
+    runStreamingWork(state, true);
+}
+
+VENUS_BENCHMARK(PooledThread_WorkQueue_PriorityBuckets, BUCKET_QUEUE_ITERATIONS) {
+    auto tasks = createTasks(state.iterations());
+    std::vector<std::shared_ptr<Task>> popped;
+    popped.reserve(tasks.size());
+
+    Venus::Utility::DataStructures::PriorityBucketQueue<std::shared_ptr<Task>, TASK_PRIORITY_LEVELS> queue;
+
+    state.startTimer();
+    for (const auto &task : tasks)
+        queue.push(getTaskPriorityLevel(task->getPriority()), task);
+
+    while (!queue.isEmpty())
+        popped.push_back(queue.pop());
+    state.stopTimer();
+
+    state.setCounter("ordered", isPriorityOrdered(popped));
+}
+
+/** The worker queue as it was, sorted by priority after every push */
+VENUS_BENCHMARK(PooledThread_WorkQueue_SortPerPush, SORTED_QUEUE_ITERATIONS) {
+    auto tasks = createTasks(state.iterations());
+    std::vector<std::shared_ptr<Task>> popped;
+    popped.reserve(tasks.size());
+
+    DeQueue<std::shared_ptr<Task>> queue;
+
+    state.startTimer();
+    for (const auto &task : tasks) {
+        queue.push_back(task);
+        std::sort(queue.begin(), queue.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs->getPriority() > rhs->getPriority();
+        });
+    }
+
+    while (!queue.empty()) {
+        popped.push_back(queue.front());
+        queue.pop_front();
+    }
+    state.stopTimer();
+
+    state.setCounter("ordered", isPriorityOrdered(popped));
+}
+
+/** The cost every traced point in the task system pays while tracing is off */
+VENUS_BENCHMARK(Tracer_Scope_Disabled, TRACE_ITERATIONS) {
+    Tracer::setEnabled(false);
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+        TraceScope trace(TraceEventType::TaskRun, "BenchTask", i);
+    state.stopTimer();
+}
+
+VENUS_BENCHMARK(Tracer_Scope_Enabled, TRACE_ITERATIONS) {
+    Tracer::setEnabled(true);
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+        TraceScope trace(TraceEventType::TaskRun, "BenchTask", i);
+    state.stopTimer();
+
+    Tracer::setEnabled(false);
+    Tracer::clear();
+}
+
+VENUS_BENCHMARK(Parallel_For_Sequential, PARALLEL_ITERATIONS) {
+    auto values = createRandomValues(state.iterations());
+    std::vector<float> results(values.size());
+
+    state.startTimer();
+    for (size_t i = 0; i < values.size(); ++i)
+        results[i] = std::sqrt(static_cast<float>(values[i]));
+    state.stopTimer();
+}
+
+VENUS_BENCHMARK(Parallel_For_ThreadPool, PARALLEL_ITERATIONS) {
+    auto values = createRandomValues(state.iterations());
+    std::vector<float> results(values.size());
+
+    state.startTimer();
+    parallelFor(size_t(0), values.size(), [&](size_t i) {
+        results[i] = std::sqrt(static_cast<float>(values[i]));
+    });
+    state.stopTimer();
+}
+
+VENUS_BENCHMARK(Parallel_Reduce_Sequential, PARALLEL_ITERATIONS) {
+    auto values = createRandomValues(state.iterations());
+
+    state.startTimer();
+    uint64_t sum = 0;
+    for (auto value : values)
+        sum += value;
+    state.stopTimer();
+
+    state.setCounter("sum", static_cast<double>(sum));
+}
+
+VENUS_BENCHMARK(Parallel_Reduce_ThreadPool, PARALLEL_ITERATIONS) {
+    auto values = createRandomValues(state.iterations());
+
+    state.startTimer();
+    auto sum = parallelReduce(size_t(0), values.size(), uint64_t(0), [&](size_t first, size_t last, uint64_t sum) {
+        for (size_t i = first; i < last; ++i)
+            sum += values[i];
+
+        return sum;
+    }, std::plus<>());
+    state.stopTimer();
+
+    state.setCounter("sum", static_cast<double>(sum));
+}
+
+VENUS_BENCHMARK(Parallel_Sort_Sequential, PARALLEL_ITERATIONS) {
+    auto values = createRandomValues(state.iterations());
+
+    state.startTimer();
+    std::sort(values.begin(), values.end());
+    state.stopTimer();
+}
+
+VENUS_BENCHMARK(Parallel_Sort_ThreadPool, PARALLEL_ITERATIONS) {
+    auto values = createRandomValues(state.iterations());
+
+    state.startTimer();
+    parallelSort(values.begin(), values.end());
+    state.stopTimer();
+
+    state.setCounter("sorted", std::is_sorted(values.begin(), values.end()) ? 1 : 0);
+}
+
+/** Waiting tasks hold on to their worker, running other pending work until their children complete */
+VENUS_BENCHMARK(TaskScheduler_TaskTree_ThreadBlocking, TASK_TREE_ITERATIONS) {
+    runTaskTrees(state, false);
+}
+
+/** Waiting tasks suspend their fiber and hand the worker back to the pool */
+VENUS_BENCHMARK(TaskScheduler_TaskTree_Fibers, TASK_TREE_ITERATIONS) {
+    runTaskTrees(state, true);
+}
+
+/**
+ * Measures the time from adding a task to the scheduler to it starting on a worker. Tasks are added one at a time, so
+ * both a spinning and a parked worker are exercised
+ */
+VENUS_BENCHMARK(TaskScheduler_AddTask_Latency, ADD_TASK_ITERATIONS) {
+    using Clock = std::chrono::steady_clock;
+
+    auto scheduler = TaskScheduler::instance();
+    std::vector<int64_t> latencies(state.iterations());
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        auto description = TaskDescription();
+        Clock::time_point addedAt;
+        description.Work = [&latencies, &addedAt, i]() {
+            latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - addedAt).count();
+        };
+
+        auto task = std::make_shared<Task>(description);
+        addedAt = Clock::now();
+        scheduler->addTask(task);
+        task->wait();
+    }
+    state.stopTimer();
+
+    std::sort(latencies.begin(), latencies.end());
+    state.setCounter("p50_ns", static_cast<double>(latencies[latencies.size() / 2]));
+    state.setCounter("p99_ns", static_cast<double>(latencies[latencies.size() * 99 / 100]));
+}
+
+/** A group of tasks fanning out over the workers, joined by a task depending on the group */
+VENUS_BENCHMARK(TaskGroup_FanOutFanIn, GROUP_ITERATIONS) {
+    auto scheduler = TaskScheduler::instance();
+    std::atomic<uint64_t> executed{0};
+    uint64_t joined = 0;
+
+    state.startTimer();
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        auto groupDescription = TaskGroupDescription();
+        groupDescription.GroupPriority = TaskPriority::Normal;
+
+        for (uint32_t task = 0; task < GROUP_FAN_OUT; ++task) {
+            auto description = TaskDescription();
+            description.Work = [&executed]() { executed.fetch_add(1, std::memory_order_relaxed); };
+            groupDescription.Tasks.push_back(description);
+        }
+
+        auto group = std::make_shared<TaskGroup>(groupDescription);
+
+        auto joinDescription = TaskDescription();
+        joinDescription.GroupDependencies.push_back(group);
+        joinDescription.Work = [&joined, &executed]() { joined = executed.load(std::memory_order_relaxed); };
+
+        auto join = std::make_shared<Task>(joinDescription);
+        scheduler->addTask(join);
+        scheduler->addTaskGroup(group);
+        join->wait();
+    }
+    state.stopTimer();
+
+    state.setCounter("joined", static_cast<double>(joined));
+}
+
+/** The frame graph compiled once, each frame only resets the graph's counters */
+VENUS_BENCHMARK(TaskGraph_Frame500_Compiled, FRAME_GRAPH_ITERATIONS) {
+    FrameValues values(FRAME_GRAPH_LAYERS * FRAME_GRAPH_WIDTH);
+    TaskGraph graph;
+
+    for (uint32_t layer = 0; layer < FRAME_GRAPH_LAYERS; ++layer) {
+        for (uint32_t column = 0; column < FRAME_GRAPH_WIDTH; ++column) {
+            uint32_t node = graph.addNode([&values, layer, column]() { runFrameNode(values, layer, column); });
+
+            if (layer > 0) {
+                graph.addDependency(node, node - FRAME_GRAPH_WIDTH);
+                graph.addDependency(node, (layer - 1) * FRAME_GRAPH_WIDTH + (column + 1) % FRAME_GRAPH_WIDTH);
+            }
+        }
+    }
+
+    graph.compile();
+
+    state.startTimer();
+    for (uint64_t frame = 0; frame < state.iterations(); ++frame)
+        graph.execute();
+    state.stopTimer();
+
+    state.setCounter("correct", isFrameCorrect(values));
+}
+
+/** The frame graph rebuilt from tasks on the TaskScheduler every frame */
+VENUS_BENCHMARK(TaskGraph_Frame500_RebuiltTasks, FRAME_GRAPH_ITERATIONS) {
+    FrameValues values(FRAME_GRAPH_LAYERS * FRAME_GRAPH_WIDTH);
+    auto scheduler = TaskScheduler::instance();
+
+    state.startTimer();
+    for (uint64_t frame = 0; frame < state.iterations(); ++frame) {
+        std::vector<std::shared_ptr<Task>> previous;
+        std::vector<std::shared_ptr<Task>> current;
+
+        for (uint32_t layer = 0; layer < FRAME_GRAPH_LAYERS; ++layer) {
+            for (uint32_t column = 0; column < FRAME_GRAPH_WIDTH; ++column) {
+                auto description = TaskDescription();
+                description.TaskName = fmt::format("FrameNode{}x{}", layer, column);
+                description.Work = [&values, layer, column]() { runFrameNode(values, layer, column); };
+
+                if (layer > 0)
+                    description.Dependencies = {previous[column], previous[(column + 1) % FRAME_GRAPH_WIDTH]};
+
+                current.push_back(std::make_shared<Task>(description));
+                scheduler->addTask(current.back());
+            }
+
+            previous = std::move(current);
+            current.clear();
+        }
+
+        for (const auto &task : previous)
+            task->wait();
+    }
+    state.stopTimer();
+
+    state.setCounter("correct", isFrameCorrect(values));
+}
@@ -37,6 +37,21 @@ namespace Venus::Core::Managers {
         return renderApi;
     }
 
+    Utility::Threading::CoroutineTask<std::shared_ptr<RenderApis::RenderApi>>
+    RenderWindowManager::createNewWindowAsync(Plugins::Glfw::WindowDescription description) {
+        auto renderWindow = std::make_shared<Venus::Core::RenderApis::RenderWindow>(std::move(description));
+        auto renderApi = std::make_shared<Venus::Core::RenderApis::RenderApi>(renderWindow);
+
+        co_await renderApi->ignitionAsync();
+
+        {
+            Lock lock(this->_windowsMutex);
+            this->_renderSurfaces.insert({renderApi->getRenderWindow()->getId(), renderApi});
+        }
+
+        co_return renderApi;
+    }
+
     void RenderWindowManager::update() {
         updateWindows();
     }
@@ -32,6 +32,13 @@ namespace Venus::Core::Managers {
         /** Creates a new render window and returns it's render API */
         std::shared_ptr<RenderApis::RenderApi> createNewWindow(Plugins::Glfw::WindowDescription description);
 
+        /**
+         * Creates a new render window without blocking the calling thread on the core thread
+         * @note The coroutine finishes on the core thread, start() it to get an AsyncResult holding the render API
+         */
+        Utility::Threading::CoroutineTask<std::shared_ptr<RenderApis::RenderApi>>
+        createNewWindowAsync(Plugins::Glfw::WindowDescription description);
+
         /**
          * Registers a new render API to the Manager
          * @note from this point the manager owns the api and will update it every frame
@@ -20,6 +20,15 @@ namespace Venus::Core::RenderApis {
         }, CTQF_InternalQueue | CTQF_BlockUntilComplete);
     }
 
+    Utility::Threading::CoroutineTask<> RenderApi::ignitionAsync() {
+        if (this->_isStarted) VENUS_EXCEPT(InvalidOperationException, "RenderApi Instance already ignited")
+
+        this->_isStarted = true;
+
+        co_await getCoreThread()->schedule();
+        this->_renderSurface->ignition();
+    }
+
     void RenderApi::_update() {
         this->_renderSurface->update();
     }
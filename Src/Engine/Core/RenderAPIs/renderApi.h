@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <coreThread.h>
+#include <Threading/coroutineTask.h>
 #include "renderSurface.h"
 
 namespace Venus::Core::Managers {
@@ -27,6 +28,12 @@ namespace Venus::Core::RenderApis {
         /** Queues initialization of the render api and the window on the core thread */
         void ignition();
 
+        /**
+         * Initialises the render api and the window on the core thread without blocking the calling thread
+         * @note The coroutine carries on running on the core thread once the window is initialised
+         */
+        Utility::Threading::CoroutineTask<> ignitionAsync();
+
         /** Retrieve the render API's window instance */
         std::shared_ptr<RenderSurface> getRenderWindow();
 
@@ -25,16 +25,17 @@ namespace Venus::Core::RenderApis {
     }
 
     void RenderWindow::update() {
-        getCoreThread()->queueCommand([this] {
-                                          this->_glfwUtility->update();
-                                      },
-                                      CTQF_InternalQueue | CTQF_BlockUntilComplete);
+        // Recorded into the application thread's frame, the utility is captured so it outlives a window closed
+        // while the frame is in flight
+        getCoreThread()->queueCommand(DiscardResult, [glfwUtility = this->_glfwUtility] {
+            glfwUtility->update();
+        });
     }
 
     void RenderWindow::resize(uint32_t width, uint32_t height) {
         auto coreThread = CoreThread::instance();
 
-        coreThread->queueCommand([this, width, height]() {
+        coreThread->queueCommand(DiscardResult, [this, width, height]() {
             {
                 Lock lock(this->_windowPropsMutex);
                 this->_windowProperties->width = width;
@@ -49,7 +50,7 @@ namespace Venus::Core::RenderApis {
     void RenderWindow::show() {
         auto coreThread = CoreThread::instance();
 
-        coreThread->queueCommand([this]() {
+        coreThread->queueCommand(DiscardResult, [this]() {
             this->_glfwUtility->showWindow(true);
         });
         coreThread->submit();
@@ -58,7 +59,7 @@ namespace Venus::Core::RenderApis {
     void RenderWindow::hide() {
         auto coreThread = CoreThread::instance();
 
-        coreThread->queueCommand([this]() {
+        coreThread->queueCommand(DiscardResult, [this]() {
             this->_glfwUtility->showWindow(false);
         });
         coreThread->submit();
@@ -25,7 +25,10 @@ namespace Venus::Core::RenderApis {
         /** Does render window initialisation */
         void ignition() override;
 
-        /** Called once per frame */
+        /**
+         * Called once per frame
+         * @note Records the window update into the calling thread's frame, it executes once the frame is submitted
+         */
         void update() override;
 
         /** @copydoc Venus::Core::RenderApis::RenderSurface */
@@ -1,16 +1,24 @@
 
 set(ENGINE_CORETHREAD_INC # include directories
         "queuedCommand.h"
+        "commandPacket.h"
+        "commandBuffer.h"
         "commandQueue.h"
         "commandQueueBase.h"
+        "priorityCommandQueue.h"
         "coreThreadQueueFlag.h"
         "coreThread.h"
+        "coreThreadExecutor.h"
         )
 
 set(ENGINE_CORETHREAD_SRC # source directories
+        "commandPacket.cpp"
+        "commandBuffer.cpp"
         "commandQueueBase.cpp"
         "commandQueue.cpp"
+        "priorityCommandQueue.cpp"
         "coreThread.cpp"
+        "coreThreadExecutor.cpp"
         )
 
 set(ENGINE_CORETHREAD_CORE_SRC
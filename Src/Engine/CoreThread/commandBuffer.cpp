@@ -0,0 +1,77 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "commandBuffer.h"
+
+namespace Venus::Core {
+    CommandBuffer::CommandBuffer() {
+        this->_commands.reserve(COMMAND_BUFFER_INITIAL_CAPACITY);
+    }
+
+    bool CommandBuffer::playBack(CommandTimePoint until) {
+        uint32_t executed = 0;
+
+        while (true) {
+            // Finish the closure range a previous slice stopped in before moving on to the next packet
+            for (; this->_playBackCommand < this->_playBackRangeEnd; ++this->_playBackCommand) {
+                if (_isOverBudget(executed, until))
+                    return false;
+
+                this->_commands[this->_playBackCommand].execute();
+            }
+
+            if (this->_playBackOffset >= this->_packetBytes)
+                break;
+
+            if (_isOverBudget(executed, until))
+                return false;
+
+            const unsigned char *packet = this->_packets.get() + this->_playBackOffset;
+            const auto *header = reinterpret_cast<const CommandPacketHeader *>(packet);
+            const unsigned char *payload = packet + sizeof(CommandPacketHeader);
+
+            this->_playBackOffset += header->size;
+
+            if (header->opcode == COMMAND_OPCODE_CLOSURE_RANGE)
+                this->_playBackRangeEnd += reinterpret_cast<const ClosureRangePacket *>(payload)->count;
+            else
+                CommandPacketTable::dispatch(header->opcode, payload);
+        }
+
+        // Closures recorded after the last packet, or every closure if no packets were recorded
+        for (auto end = static_cast<uint32_t>(this->_commands.size()); this->_playBackCommand < end;
+             ++this->_playBackCommand) {
+            if (_isOverBudget(executed, until))
+                return false;
+
+            this->_commands[this->_playBackCommand].execute();
+        }
+
+        this->clear();
+        return true;
+    }
+
+    void CommandBuffer::clear() {
+        this->_commands.clear();
+        this->_markedCommands = 0;
+        this->_packetBytes = 0;
+
+        this->_playBackCommand = 0;
+        this->_playBackRangeEnd = 0;
+        this->_playBackOffset = 0;
+    }
+
+    void CommandBuffer::_growPackets(size_t requiredBytes) {
+        size_t capacity = this->_packetCapacity == 0 ? COMMAND_BUFFER_INITIAL_PACKET_BYTES : this->_packetCapacity;
+        while (capacity < requiredBytes)
+            capacity *= 2;
+
+        auto packets = std::make_unique<unsigned char[]>(capacity);
+        if (this->_packetBytes > 0)
+            std::memcpy(packets.get(), this->_packets.get(), this->_packetBytes);
+
+        this->_packets = std::move(packets);
+        this->_packetCapacity = capacity;
+    }
+}
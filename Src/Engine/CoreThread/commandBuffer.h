@@ -0,0 +1,147 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_COMMANDBUFFER_H
+#define VENUS_COMMANDBUFFER_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include "queuedCommand.h"
+#include "commandPacket.h"
+
+namespace Venus::Core {
+    /** Number of commands a new command buffer reserves room for */
+    static constexpr uint32_t COMMAND_BUFFER_INITIAL_CAPACITY = 64;
+
+    /** Number of packet bytes a new command buffer reserves room for */
+    static constexpr uint32_t COMMAND_BUFFER_INITIAL_PACKET_BYTES = 4096;
+
+    /**
+     * A contiguous block of commands recorded by a single thread and played back on the core thread.
+     *
+     * Commands are either closures or typed packets. Packets are copied into a linear, bump allocated byte stream
+     * and dispatched through the CommandPacketTable. Closures live in their own array, whenever a packet follows
+     * closures a range marker is written to the stream so play back preserves the recording order.
+     *
+     * @note Buffers are recycled by their owning CommandQueueBase, clearing a buffer keeps its capacity so a warmed up
+     * buffer records commands without allocating.
+     */
+    class CommandBuffer {
+    public:
+        CommandBuffer();
+
+        CommandBuffer(const CommandBuffer &) = delete;
+
+        CommandBuffer &operator=(const CommandBuffer &) = delete;
+
+        /** Appends a command to the end of the buffer */
+        void push(QueuedCommand &&command) {
+            this->_commands.push_back(std::move(command));
+        }
+
+        /**
+         * Appends a copy of the packet to the end of the buffer
+         * @note Exception is thrown if the packet type is not registered with CommandPacketTable
+         */
+        template<typename Packet>
+        void record(const Packet &packet) {
+            CommandPacketTable::validatePacket<Packet>();
+            CommandPacketTable::requireRegistered<Packet>();
+
+            this->_markClosureRange();
+            std::memcpy(this->_writePacket(Packet::Opcode, sizeof(Packet)), &packet, sizeof(Packet));
+        }
+
+        /**
+         * Executes the recorded commands in order, then clears the buffer.
+         *
+         * @param until Once this point in time has passed play back stops, remembering where it got to so the next
+         * call resumes with the following command. The clock is only read every COMMAND_BUDGET_CHECK_INTERVAL
+         * commands, so a slice can overrun by that many commands and always executes at least one.
+         * @return True if every command has executed and the buffer was cleared
+         */
+        bool playBack(CommandTimePoint until = NO_COMMAND_DEADLINE);
+
+        /** Destroys all the recorded commands without executing them */
+        void clear();
+
+        /** Returns true if no commands are recorded */
+        [[nodiscard]] bool isEmpty() const {
+            return this->_commands.empty() && this->_packetBytes == 0;
+        }
+
+        /** Returns the number of recorded closures */
+        [[nodiscard]] uint32_t size() const {
+            return static_cast<uint32_t>(this->_commands.size());
+        }
+
+    private:
+        friend class CommandQueueBase;
+
+        /** Writes a closure range marker covering the closures recorded since the last marker, if any */
+        void _markClosureRange() {
+            auto unmarked = static_cast<uint32_t>(this->_commands.size()) - this->_markedCommands;
+
+            if (unmarked == 0)
+                return;
+
+            ClosureRangePacket range{unmarked};
+            std::memcpy(this->_writePacket(COMMAND_OPCODE_CLOSURE_RANGE, sizeof(range)), &range, sizeof(range));
+            this->_markedCommands += unmarked;
+        }
+
+        /**
+         * Bump allocates a packet in the stream and writes its header
+         * @return Pointer to where the payload must be written
+         */
+        unsigned char *_writePacket(CommandOpcode opcode, uint32_t payloadSize) {
+            uint32_t packetSize = sizeof(CommandPacketHeader) +
+                                  ((payloadSize + COMMAND_PACKET_ALIGNMENT - 1) & ~(COMMAND_PACKET_ALIGNMENT - 1));
+
+            if (this->_packetBytes + packetSize > this->_packetCapacity)
+                this->_growPackets(this->_packetBytes + packetSize);
+
+            unsigned char *packet = this->_packets.get() + this->_packetBytes;
+            this->_packetBytes += packetSize;
+
+            auto *header = reinterpret_cast<CommandPacketHeader *>(packet);
+            header->opcode = opcode;
+            header->reserved = 0;
+            header->size = packetSize;
+
+            return packet + sizeof(CommandPacketHeader);
+        }
+
+        /** Grows the packet stream to hold at least the given number of bytes */
+        void _growPackets(size_t requiredBytes);
+
+        /**
+         * Returns true if the budget was exhausted, reading the clock only once every few executed commands. The clock
+         * is first read after one command, so every slice makes progress even if it starts over budget.
+         */
+        static bool _isOverBudget(uint32_t &executed, CommandTimePoint until) {
+            return until != NO_COMMAND_DEADLINE && executed++ % COMMAND_BUDGET_CHECK_INTERVAL == 1 &&
+                   CommandClock::now() >= until;
+        }
+
+        std::vector<QueuedCommand> _commands;
+        uint32_t _markedCommands{0};
+
+        std::unique_ptr<unsigned char[]> _packets;
+        size_t _packetBytes{0};
+        size_t _packetCapacity{0};
+
+        /** Where a budgeted play back stopped, the next closure, the end of its range and the next packet */
+        uint32_t _playBackCommand{0};
+        uint32_t _playBackRangeEnd{0};
+        size_t _playBackOffset{0};
+
+        /** Intrusive link used while the buffer sits in its owner's recycled list */
+        CommandBuffer *_nextRecycled{nullptr};
+    };
+}
+
+#endif //VENUS_COMMANDBUFFER_H
@@ -0,0 +1,28 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "commandPacket.h"
+#include <Error/venusExceptions.h>
+
+namespace Venus::Core {
+    std::array<CommandPacketHandler, MAX_COMMAND_OPCODES> CommandPacketTable::_handlers{};
+
+    bool CommandPacketTable::isRegistered(CommandOpcode opcode) {
+        return opcode < MAX_COMMAND_OPCODES && _handlers[opcode] != nullptr;
+    }
+
+    void CommandPacketTable::_registerHandler(CommandOpcode opcode, CommandPacketHandler handler) {
+        if (_handlers[opcode] != nullptr && _handlers[opcode] != handler) {
+            VENUS_EXCEPT(InvalidOperationException, "Command packet opcode is already registered.");
+        }
+
+        _handlers[opcode] = handler;
+    }
+
+    void CommandPacketTable::_throwIfNotRegistered(CommandOpcode opcode) {
+        if (!isRegistered(opcode)) {
+            VENUS_EXCEPT(InternalErrorException, "No handler registered for command packet opcode.");
+        }
+    }
+}
@@ -0,0 +1,117 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_COMMANDPACKET_H
+#define VENUS_COMMANDPACKET_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace Venus::Core {
+    /** Identifies the handler a command packet is dispatched to */
+    typedef uint16_t CommandOpcode;
+
+    /** Size of the opcode jump table, valid opcodes are 1 to MAX_COMMAND_OPCODES - 1 */
+    static constexpr uint32_t MAX_COMMAND_OPCODES = 256;
+
+    /** Reserved opcode marking a run of closures recorded between packets */
+    static constexpr CommandOpcode COMMAND_OPCODE_CLOSURE_RANGE = 0;
+
+    /** Every packet starts, and is padded to, a multiple of this many bytes */
+    static constexpr uint32_t COMMAND_PACKET_ALIGNMENT = 8;
+
+    /** Precedes the payload of every packet written to a command buffer */
+    struct CommandPacketHeader {
+        CommandOpcode opcode;
+        uint16_t reserved;
+
+        /** Size of the header plus padded payload, the offset to the next packet */
+        uint32_t size;
+    };
+
+    static_assert(sizeof(CommandPacketHeader) % COMMAND_PACKET_ALIGNMENT == 0);
+
+    /** Payload of the COMMAND_OPCODE_CLOSURE_RANGE packet */
+    struct ClosureRangePacket {
+        uint32_t count;
+    };
+
+    /** Executes a packet payload */
+    typedef void (*CommandPacketHandler)(const void *payload);
+
+    /**
+     * Jump table mapping opcodes to packet handlers.
+     *
+     * A packet is a trivially copyable struct with a unique opcode and a static execute method, e.g.
+     * @code
+     * struct SetViewportPacket {
+     *     static constexpr CommandOpcode Opcode = 1;
+     *     uint32_t width, height;
+     *
+     *     static void execute(const SetViewportPacket &packet);
+     * };
+     * @endcode
+     *
+     * @note Packets must be registered before they are recorded, registration is not thread safe and is expected
+     * to happen during start up.
+     */
+    class CommandPacketTable {
+    public:
+        /** Registers the packet type's execute method under its opcode */
+        template<typename Packet>
+        static void registerPacket() {
+            validatePacket<Packet>();
+
+            _registerHandler(Packet::Opcode, [](const void *payload) {
+                Packet::execute(*static_cast<const Packet *>(payload));
+            });
+        }
+
+        /** Returns true if a handler is registered for the opcode */
+        static bool isRegistered(CommandOpcode opcode);
+
+        /**
+         * Throws if the packet type is not registered, the check only runs until it first passes for the type
+         * @note Exception is thrown if no handler is registered for the packet's opcode
+         */
+        template<typename Packet>
+        static void requireRegistered() {
+            // A throwing initialiser leaves the static uninitialised, so an unregistered packet is checked again
+            [[maybe_unused]] static const bool registered = (_throwIfNotRegistered(Packet::Opcode), true);
+        }
+
+        /**
+         * Executes the payload with the handler registered for the opcode
+         * @note Packets are checked for a handler when recorded, debug builds check again here
+         */
+        static void dispatch(CommandOpcode opcode, const void *payload) {
+#if DEBUG
+            _throwIfNotRegistered(opcode);
+#endif
+            _handlers[opcode](payload);
+        }
+
+        /** Compile time checks a type satisfies the packet requirements */
+        template<typename Packet>
+        static constexpr void validatePacket() {
+            static_assert(std::is_trivially_copyable_v<Packet>, "Command packets must be trivially copyable");
+            static_assert(std::is_trivially_destructible_v<Packet>, "Command packets must be trivially destructible");
+            static_assert(alignof(Packet) <= COMMAND_PACKET_ALIGNMENT, "Command packet is over aligned");
+            static_assert(std::is_convertible_v<decltype(Packet::Opcode), CommandOpcode>,
+                          "Command packets must declare a static Opcode");
+            static_assert(Packet::Opcode != COMMAND_OPCODE_CLOSURE_RANGE && Packet::Opcode < MAX_COMMAND_OPCODES,
+                          "Command packet opcode is reserved or out of range");
+        }
+
+    private:
+        static void _registerHandler(CommandOpcode opcode, CommandPacketHandler handler);
+
+        static void _throwIfNotRegistered(CommandOpcode opcode);
+
+        static std::array<CommandPacketHandler, MAX_COMMAND_OPCODES> _handlers;
+    };
+}
+
+#endif //VENUS_COMMANDPACKET_H
@@ -27,4 +27,99 @@ namespace Venus::Core {
     LockGuard CommandQueueUnSynced::lock() {
         return LockGuard();
     }
+
+    CommandQueueLockFree::CommandQueueLockFree(ThreadId id)
+            : _ring(RING_CAPACITY),
+              _consumerThreadId(id) {}
+
+    bool CommandQueueLockFree::isValidThread() {
+        return true;
+    }
+
+    LockGuard CommandQueueLockFree::lock() {
+        return LockGuard();
+    }
+
+    CommandQueue<CommandQueueLockFree>::CommandQueue(ThreadId id)
+            : CommandQueueBase(id),
+              CommandQueueLockFree(id) {}
+
+    void CommandQueue<CommandQueueLockFree>::queueCommand(QueuedCommand &&command) {
+        this->queueCommand(std::move(command), NO_COMMAND_DEADLINE);
+    }
+
+    void CommandQueue<CommandQueueLockFree>::queueCommand(QueuedCommand &&command, CommandTimePoint deadline) {
+        PendingCommand pending = CommandQueue<CommandQueueLockFree>::createPending(std::move(command), deadline);
+
+        while (!this->tryPublish(pending)) {
+            if (THREAD_CURRENT_ID == this->_consumerThreadId)
+                this->playBackPending();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    PendingCommand CommandQueue<CommandQueueLockFree>::createPending(QueuedCommand &&command,
+                                                                     CommandTimePoint deadline) {
+        static thread_local uint32_t publishedCommands = 0;
+
+        CommandTimePoint queuedAt{};
+        if (publishedCommands++ % COMMAND_WAIT_TIME_SAMPLE_RATE == 0)
+            queuedAt = CommandClock::now();
+
+        return PendingCommand{std::move(command), queuedAt, deadline};
+    }
+
+    bool CommandQueue<CommandQueueLockFree>::tryPublish(PendingCommand &pending) {
+        // The ring only moves from the command once it has claimed a cell for it
+        return this->_ring.tryPush(std::move(pending));
+    }
+
+    uint32_t CommandQueue<CommandQueueLockFree>::playBackPending() {
+        this->_throwIfNotConsumer();
+
+        uint32_t executed = 0;
+        while (auto pending = this->_ring.tryPop()) {
+            pending->command.execute();
+            ++executed;
+        }
+
+        return executed;
+    }
+
+    std::optional<PendingCommand> CommandQueue<CommandQueueLockFree>::tryPop() {
+        this->_throwIfNotConsumer();
+
+        return this->_ring.tryPop();
+    }
+
+    uint32_t CommandQueue<CommandQueueLockFree>::size() {
+        return this->_ring.size();
+    }
+
+    void CommandQueue<CommandQueueLockFree>::cancelAll() {
+        this->_throwIfNotConsumer();
+
+        while (this->_ring.tryPop());
+    }
+
+    bool CommandQueue<CommandQueueLockFree>::isEmpty() {
+        return this->_ring.isEmpty();
+    }
+
+    CommandBuffer *CommandQueue<CommandQueueLockFree>::flushQueue() {
+        this->_throwIfNotConsumer();
+
+        while (auto pending = this->_ring.tryPop())
+            CommandQueueBase::queueCommand(std::move(pending->command));
+
+        return CommandQueueBase::flushQueue();
+    }
+
+    void CommandQueue<CommandQueueLockFree>::_throwIfNotConsumer() {
+#if DEBUG
+        if (THREAD_CURRENT_ID != this->_consumerThreadId)
+            CommandQueueBase::throwInvalidThreadException("Lock-free command queue consumed outside of its consumer thread.");
+#endif
+    }
 }
\ No newline at end of file
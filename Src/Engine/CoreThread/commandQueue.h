@@ -6,6 +6,7 @@
 #define VENUS_COMMANDQUEUE_H
 
 #include "commandQueueBase.h"
+#include <Datastructures/mpscRingBuffer.h>
 
 namespace Venus::Core {
     /** Provides a lock for synchronization */
@@ -50,6 +51,35 @@ namespace Venus::Core {
         ThreadId _threadId;
     };
 
+    /** One in this many commands published to a lock-free queue is time stamped */
+    static constexpr uint32_t COMMAND_WAIT_TIME_SAMPLE_RATE = 16;
+
+    /**
+     * Command queue policy for queues with many producers and a single consumer. Commands are pushed into a bounded
+     * lock-free ring buffer, so neither the producers nor the consumer ever take a lock.
+     */
+    class CommandQueueLockFree {
+    public:
+        /** The number of commands the ring can hold before producers have to wait for the consumer */
+        static constexpr uint32_t RING_CAPACITY = 4096;
+
+        /**
+         * Constructor
+         * @param id The thread identifier of the consumer, the only thread allowed to play back the queue
+         */
+        explicit CommandQueueLockFree(ThreadId id);
+
+        /** Returns true */
+        static bool isValidThread();
+
+        /** Returns an empty lock guard, the ring buffer provides its own synchronization */
+        LockGuard lock();
+
+    protected:
+        Utility::DataStructures::MPSCRingBuffer<PendingCommand> _ring;
+        ThreadId _consumerThreadId;
+    };
+
     /**
      * Manages a list of commands that can be queued for later execution on the core thread.
      */
@@ -60,31 +90,25 @@ namespace Venus::Core {
                 : CommandQueueBase(id),
                   SyncPolicy(id) {}
 
-        /**
-         * Queue up a new command to execute,
-         * @note provided command is not queue to have it's return value returned
-         *
-         * @param commandCallback   The command to be queued for execution
-         * @param _callbackId       (optional) Identifier for the callback so you can then later find
-         * 									   it if needed.
-         */
-        std::shared_ptr<AsyncResult> queueVoidCommand(std::function<void()> commandCallback) override {
+        /** @copydoc CommandQueueBase::queueCommand */
+        void queueCommand(QueuedCommand &&command) override {
 #if DEBUG
             if (!this->isValidThread())
                 CommandQueueBase::throwInvalidThreadException("Command queue accessed outside of its creation thread.");
 #endif
             LockGuard lockGuard = this->lock();
-            return CommandQueueBase::queueVoidCommand(commandCallback);
+            CommandQueueBase::queueCommand(std::move(command));
         }
 
-        std::shared_ptr<AsyncResult>
-        queueReturningCommand(std::function<GenericObject()> commandCallback) override {
+        /** @copydoc CommandQueueBase::queuePacket */
+        template<typename Packet>
+        void queuePacket(const Packet &packet) {
 #if DEBUG
             if (!this->isValidThread())
                 CommandQueueBase::throwInvalidThreadException("Command queue accessed outside of its creation thread.");
 #endif
             LockGuard lockGuard = this->lock();
-            return CommandQueueBase::queueReturningCommand(commandCallback);
+            CommandQueueBase::queuePacket(packet);
         }
 
         /** Cancels all queued commands. */
@@ -107,8 +131,8 @@ namespace Venus::Core {
             return CommandQueueBase::isEmpty();
         }
 
-        /** @copydoc CommandQueueBase::flush */
-        std::shared_ptr<Queue<QueuedCommand>> flushQueue() override {
+        /** @copydoc CommandQueueBase::flushQueue */
+        CommandBuffer *flushQueue() override {
 #if DEBUG
             if (!this->isValidThread())
                 CommandQueueBase::throwInvalidThreadException("Command queue accessed outside of its creation thread.");
@@ -118,5 +142,80 @@ namespace Venus::Core {
             return CommandQueueBase::flushQueue();
         }
     };
+
+    /**
+     * Command queue that any thread may push to without locking, while only the consumer thread plays it back.
+     */
+    template<>
+    class CommandQueue<CommandQueueLockFree> : public CommandQueueBase, public CommandQueueLockFree {
+    public:
+        explicit CommandQueue(ThreadId id);
+
+        /**
+         * Publishes the command to the ring. If the ring is full the consumer drains it in place, while any
+         * other thread yields until the consumer makes room.
+         */
+        void queueCommand(QueuedCommand &&command) override;
+
+        /**
+         * Publishes the command to the ring, blocking the same way as queueCommand(QueuedCommand &&) when it is full
+         * @param command The command to be queued for execution
+         * @param deadline When the command should have executed by
+         */
+        void queueCommand(QueuedCommand &&command, CommandTimePoint deadline);
+
+        /**
+         * Wraps the command for publishing. Reading the clock is comparable in cost to queueing a command, so only one
+         * in COMMAND_WAIT_TIME_SAMPLE_RATE commands per producer is time stamped for wait time measurements.
+         * @param command The command to be queued for execution
+         * @param deadline When the command should have executed by
+         */
+        static PendingCommand createPending(QueuedCommand &&command, CommandTimePoint deadline);
+
+        /**
+         * Publishes the command if the ring has room
+         * @return False if the ring is full, the command is left untouched
+         */
+        bool tryPublish(PendingCommand &pending);
+
+        /**
+         * Pops the oldest published command without executing it
+         * @note Must be called from the consumer thread
+         */
+        std::optional<PendingCommand> tryPop();
+
+        /** Returns the approximate number of published commands */
+        uint32_t size();
+
+        /** Packets are recorded into per-thread command buffers only, the ring holds closures */
+        template<typename Packet>
+        void queuePacket(const Packet &packet) = delete;
+
+        /**
+         * Cancels all queued commands.
+         * @note Must be called from the consumer thread
+         */
+        void cancelAll() override;
+
+        /**	Returns true if no commands are queued. */
+        bool isEmpty() override;
+
+        /**
+         * Moves all the published commands into a command buffer.
+         * @note Must be called from the consumer thread
+         */
+        CommandBuffer *flushQueue() override;
+
+        /**
+         * Executes commands until the ring is empty, including any published while playing back
+         * @note Must be called from the consumer thread
+         * @return The number of commands executed
+         */
+        uint32_t playBackPending();
+
+    private:
+        /** Throws if the calling thread is not the consumer */
+        void _throwIfNotConsumer();
+    };
 }
 #endif //VENUS_COMMANDQUEUE_H
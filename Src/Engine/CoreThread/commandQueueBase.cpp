@@ -9,51 +9,53 @@
 namespace Venus::Core {
     CommandQueueBase::CommandQueueBase(ThreadId id)
             : _threadId(id) {
-        this->_queue = std::make_shared<Queue<QueuedCommand>>();
+        this->_buffers.reserve(COMMAND_BUFFER_COUNT);
+
+        for (uint32_t i = 0; i < COMMAND_BUFFER_COUNT; ++i) {
+            auto &buffer = this->_buffers.emplace_back(std::make_unique<CommandBuffer>());
+
+            buffer->_nextRecycled = this->_freeBuffers;
+            this->_freeBuffers = buffer.get();
+        }
+
+        this->_recordingBuffer = this->_acquireBuffer();
+    }
+
+    void CommandQueueBase::queueCommand(QueuedCommand &&command) {
+        this->_recordingBuffer->push(std::move(command));
     }
 
     std::shared_ptr<AsyncResult> CommandQueueBase::queueVoidCommand(std::function<void()> commandCallback) {
         auto asyncResult = std::make_shared<AsyncResultObject>();
-        QueuedCommand newCommand(std::move(commandCallback), asyncResult);
+        this->queueCommand(QueuedCommand::create(std::move(commandCallback), asyncResult));
 
-        this->_queue->push(newCommand);
         return asyncResult;
     }
 
     std::shared_ptr<AsyncResult>
     CommandQueueBase::queueReturningCommand(std::function<GenericObject()> commandCallback) {
         auto asyncResult = std::make_shared<AsyncResultObject>();
-        QueuedCommand newCommand(std::move(commandCallback), asyncResult);
+        this->queueCommand(QueuedCommand::createReturning(std::move(commandCallback), asyncResult));
 
-        this->_queue->push(newCommand);
         return asyncResult;
     }
 
-    void CommandQueueBase::playBack(const std::weak_ptr<Queue<QueuedCommand>> &queue) {
+    bool CommandQueueBase::playBack(CommandBuffer *buffer, CommandTimePoint until) {
         THROW_IF_NOT_CORE_THREAD
 
-        auto q = queue.lock();
-
-        if (q->empty())
-            return;
-
-        while (!q->empty()) {
+        if (!buffer->playBack(until))
+            return false;
 
-            auto command = q->front();
-            command.execute();
-
-            q->pop();
-        }
+        this->_recycleBuffer(buffer);
+        return true;
     }
 
     void CommandQueueBase::cancelAll() {
-
-        while (!this->_queue->empty())
-            this->_queue->pop();
+        this->_recordingBuffer->clear();
     }
 
     bool CommandQueueBase::isEmpty() {
-        return this->_queue->empty();
+        return this->_recordingBuffer->isEmpty();
     }
 
     void CommandQueueBase::throwInvalidThreadException(const std::string &message) {
@@ -64,11 +66,34 @@ namespace Venus::Core {
         callbackId = this->_lastCallbackId++;
     }
 
-    std::shared_ptr<Queue<QueuedCommand>> CommandQueueBase::flushQueue() {
-        auto flushed = this->_queue;
-        this->_queue = std::make_shared<Queue<QueuedCommand>>();
+    CommandBuffer *CommandQueueBase::flushQueue() {
+        CommandBuffer *flushed = this->_recordingBuffer;
+        this->_recordingBuffer = this->_acquireBuffer();
 
         return flushed;
     }
-}
 
+    CommandBuffer *CommandQueueBase::_acquireBuffer() {
+        // Only the owning thread takes buffers, so the whole recycled list can be claimed without an ABA hazard
+        if (this->_freeBuffers == nullptr)
+            this->_freeBuffers = this->_recycledBuffers.exchange(nullptr, std::memory_order_acquire);
+
+        if (this->_freeBuffers == nullptr)
+            return this->_buffers.emplace_back(std::make_unique<CommandBuffer>()).get();
+
+        CommandBuffer *buffer = this->_freeBuffers;
+        this->_freeBuffers = buffer->_nextRecycled;
+        buffer->_nextRecycled = nullptr;
+
+        return buffer;
+    }
+
+    void CommandQueueBase::_recycleBuffer(CommandBuffer *buffer) {
+        CommandBuffer *head = this->_recycledBuffers.load(std::memory_order_relaxed);
+
+        do {
+            buffer->_nextRecycled = head;
+        } while (!this->_recycledBuffers.compare_exchange_weak(head, buffer, std::memory_order_release,
+                                                               std::memory_order_relaxed));
+    }
+}
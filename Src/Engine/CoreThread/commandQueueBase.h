@@ -6,13 +6,19 @@
 #define VENUS_COMMANDQUEUEBASE_H
 
 #include <Threading/threading.h>
-#include <queue>
 #include <genericObject.h>
+#include <atomic>
+#include <memory>
+#include <vector>
 #include "queuedCommand.h"
+#include "commandBuffer.h"
 
 namespace Venus::Core {
     /**
      * Manages a list of commands that can be queued for execution on the core thread
+     *
+     * @note Commands are recorded into a CommandBuffer. Flushing swaps in a recycled buffer, so submitting never copies
+     * or allocates once the buffers have warmed up. Played back buffers are handed back to the queue without locking.
      */
     class CommandQueueBase {
     public:
@@ -27,31 +33,49 @@ namespace Venus::Core {
             return this->_threadId;
         }
 
+        /** Number of command buffers a queue starts with, one recording and the rest in flight or free */
+        static constexpr uint32_t COMMAND_BUFFER_COUNT = 3;
+
+        /**
+         * Executes the commands in the buffer one by one in order, then returns the buffer to this queue.
+         *
+         * @param buffer A buffer previously returned by flushQueue() on this queue
+         * @param until When to stop executing commands. A buffer that is not finished by then stays with the caller
+         * and must be passed back in to resume play back.
+         * @note Must be called from the core thread
+         * @return True if every command has executed and the buffer was returned to this queue
+         */
+        bool playBack(CommandBuffer *buffer, CommandTimePoint until = NO_COMMAND_DEADLINE);
+
+        /**
+         * Queues up an already constructed command to execute
+         * @param command The command to be queued for execution
+         */
+        virtual void queueCommand(QueuedCommand &&command);
+
         /**
-         * Executes all the current commands one by one in order.
+         * Records a typed command packet to execute
+         * @param packet The packet, copied into the recording buffer
          */
-        static void playBack(const std::weak_ptr<Queue<QueuedCommand>> &queue);
+        template<typename Packet>
+        void queuePacket(const Packet &packet) {
+            this->_recordingBuffer->record(packet);
+        }
 
         /**
         * Queue up a new void command to execute,
         * @note provided command is not queue to have it's return value returned
         *
         * @param commandCallback   The command to be queued for execution
-        * @param _callbackId       Identifier for the callback so you can then later find
-        * 									   it if needed.
         */
-        virtual std::shared_ptr<AsyncResult> queueVoidCommand(std::function<void()> commandCallback);
+        std::shared_ptr<AsyncResult> queueVoidCommand(std::function<void()> commandCallback);
 
         /**
-         * Queue up a new command to execute. A GenericObject will be passed as the last parameter of the callback
+         * Queue up a new command to execute. The value returned by the callback is stored in the async result
          *
          * @param commandCallback       The command to be queued for execution
-         * @param notifyWhenComplete    Call the notify method (provided in the call to playback()) when the command
-         *                                     is complete.
-         * @param _callbackId           Identifier for the callback so you can then later find
-         * 									   it if needed.
          */
-        virtual std::shared_ptr<AsyncResult> queueReturningCommand(std::function<GenericObject()> commandCallback);
+        std::shared_ptr<AsyncResult> queueReturningCommand(std::function<GenericObject()> commandCallback);
 
         /** Cancels all queued commands. */
         virtual void cancelAll();
@@ -66,12 +90,12 @@ namespace Venus::Core {
         virtual void genCallbackId(uint32_t &callbackId);
 
         /**
-         * Returns a copy of all queued commands and makes room for new ones.
+         * Detaches the buffer holding all queued commands and starts recording into a recycled one.
          *
          * @note Must be called from the thread that created the command queue.
-         * @return
+         * @return The filled buffer, ownership stays with this queue and it must be handed back through playBack()
          */
-        virtual std::shared_ptr<Queue<QueuedCommand>> flushQueue();
+        virtual CommandBuffer *flushQueue();
 
     protected:
 
@@ -81,8 +105,18 @@ namespace Venus::Core {
         ~CommandQueueBase() = default;
 
     private:
+        /** Returns a free buffer, collecting recycled ones first and growing the pool if every buffer is in flight */
+        CommandBuffer *_acquireBuffer();
+
+        /** Hands a played back buffer to the recycled list, safe to call from any thread */
+        void _recycleBuffer(CommandBuffer *buffer);
+
         ThreadId _threadId{};
-        std::shared_ptr<Queue<QueuedCommand>> _queue{nullptr};
+
+        std::vector<std::unique_ptr<CommandBuffer>> _buffers;
+        CommandBuffer *_recordingBuffer{nullptr};
+        CommandBuffer *_freeBuffers{nullptr};
+        std::atomic<CommandBuffer *> _recycledBuffers{nullptr};
 
         std::atomic_int _lastCallbackId{0};
     };
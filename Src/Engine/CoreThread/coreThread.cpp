@@ -7,6 +7,8 @@
 #include <utility>
 #include "queuedCommand.h"
 #include <Threading/TaskScheduler/taskScheduler.h>
+#include <Threading/venusThread.h>
+#include <Threading/trace.h>
 
 namespace Venus::Core {
     std::weak_ptr<CoreThread>  CoreThread::_coreThreadInstance;
@@ -20,7 +22,7 @@ namespace Venus::Core {
         this->_workerThread = THREAD_CURRENT_ID;
         this->_coreThreadId = this->_workerThread; // for now
 
-        this->_commandQueue = std::make_shared<CommandQueue<CommandQueueSync>>(this->_coreThreadId);
+        this->_commandQueue = std::make_shared<PriorityCommandQueue>(this->_coreThreadId);
 #ifdef SUPPORTS_PTHREAD
         configurePThread();
 #endif
@@ -62,90 +64,157 @@ namespace Venus::Core {
             this->_coreThreadId = THREAD_CURRENT_ID;
         }
 
+        Utility::Threading::Tracer::setThreadName(CORE_THREAD_NAME);
+
         while (true) {
+            auto budget = this->_playbackBudget.load(std::memory_order_relaxed);
+            this->_iterationDeadline = budget.count() == 0 ? NO_COMMAND_DEADLINE : CommandClock::now() + budget;
+
+            // Only playbacks that ran a command are recorded, the loop checks for commands far more often than not
+            bool tracing = Utility::Threading::Tracer::isEnabled();
+            uint64_t playbackStart = tracing ? Utility::Threading::Tracer::now() : 0;
+
+            if (uint32_t played = this->_commandQueue->playBackPending(this->_iterationDeadline); played > 0) {
+                if (tracing) {
+                    Utility::Threading::Tracer::record(Utility::Threading::TraceEventType::CommandPlayback,
+                                                       "CommandPlayback", played, playbackStart,
+                                                       Utility::Threading::Tracer::now() - playbackStart);
+                }
 
-            std::shared_ptr<Queue<QueuedCommand>> commands = nullptr;
-            {
-                Lock lock(this->_commandQueueMutex);
+                continue;
+            }
 
-                while (this->_commandQueue->isEmpty()) {
+            if (this->_spinForCommands())
+                continue;
 
-                    if (this->_shutdownCoreThread)
-                        return;
+            if (!this->_parkUntilCommandReady())
+                break;
+        }
 
-                    Venus::Utility::Threading::TaskScheduler::instance()->addWorker();
-                    this->_commandReadySignal.wait(lock);
-                    Venus::Utility::Threading::TaskScheduler::instance()->removeWorker();
-                }
+        spdlog::info("CoreThread loop Terminated");
+    }
+
+    bool CoreThread::_spinForCommands() {
+        static constexpr uint32_t MAX_PAUSE_ITERATIONS = 64;
+
+        // With a single hardware thread spinning only delays the producer we are waiting for
+        static const bool canSpin = THREAD_HARDWARE_CONCURRENCY > 1;
+        if (!canSpin)
+            return !this->_commandQueue->isEmpty();
+
+        auto spinEnd = std::chrono::steady_clock::now() + CORE_THREAD_SPIN_DURATION;
+        uint32_t pauseIterations = 1;
+
+        while (this->_commandQueue->isEmpty()) {
+            if (pauseIterations <= MAX_PAUSE_ITERATIONS) {
+                for (uint32_t i = 0; i < pauseIterations; ++i)
+                    THREAD_CPU_RELAX();
 
-                commands = this->_commandQueue->flushQueue();
+                pauseIterations *= 2;
+            } else if (std::chrono::steady_clock::now() < spinEnd) {
+                std::this_thread::yield();
+            } else {
+                return false;
             }
+        }
+
+        return true;
+    }
+
+    bool CoreThread::_parkUntilCommandReady() {
+        Lock lock(this->_commandReadyCondition);
+
+        // A timed wait costs a kernel timer on every park, so the previous park decides whether this one is long
+        bool lendToThreadPool = this->_lastParkDuration >= CORE_THREAD_LONG_SLEEP;
+        if (lendToThreadPool)
+            Venus::Utility::Threading::TaskScheduler::instance()->addWorker();
 
-            this->_commandQueue->playBack(commands);
+        auto parkedAt = std::chrono::steady_clock::now();
+
+        // Producers only signal once they observe the core thread as parked, the fence orders our parked flag
+        // with the emptiness check below against their publish followed by their read of the flag.
+        this->_coreThreadParked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        while (this->_commandQueue->isEmpty()) {
+            if (this->_shutdownCoreThread)
+                break;
+
+            this->_commandReadySignal.wait(lock);
+
+            // The waking producer clears the flag, re-arm it in case this was a spurious wake up
+            this->_coreThreadParked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
         }
 
-        spdlog::info("CoreThread loop Terminated");
+        this->_coreThreadParked.store(false, std::memory_order_relaxed);
+        this->_lastParkDuration = std::chrono::steady_clock::now() - parkedAt;
+
+        if (lendToThreadPool)
+            Venus::Utility::Threading::TaskScheduler::instance()->removeWorker();
+
+        return !this->_shutdownCoreThread || !this->_commandQueue->isEmpty();
     }
 
     void CoreThread::shutdown() {
         Module::shutdown();
         {
-            Lock lock(this->_commandQueueMutex);
+            Lock lock(this->_commandReadyCondition);
             this->_shutdownCoreThread = true;
         }
 
         this->_commandReadySignal.notify_all();
     }
 
-    std::shared_ptr<AsyncResult> CoreThread::queueCommand(std::function<void()> commandCallback,
-                                                          const Venus::Core::CoreThreadQueueFlags &flags) {
-        if (flags.isSet(CTQF_InternalQueue))
-            return addVoidToInternalQueue(commandCallback, flags);
-        else
-            return this->getQueue()->queueVoidCommand(commandCallback);
+    void CoreThread::_queueCommand(QueuedCommand &&command, const CoreThreadQueueFlags &flags,
+                                   CommandTimePoint deadline) {
+        if (flags.isSet(CTQF_InternalQueue)) {
+            this->_commandQueue->queueCommand(std::move(command), _getLane(flags), deadline);
+            this->_notifyCommandReady();
+            return;
+        }
+
+        if (flags.isSet(CTQF_Realtime) || flags.isSet(CTQF_Background) || deadline != NO_COMMAND_DEADLINE) {
+            VENUS_EXCEPT(InvalidOperationException,
+                         "Priorities and deadlines only apply to commands queued on the internal queue.");
+        }
+
+        this->getQueue()->queueCommand(std::move(command));
     }
 
-    std::shared_ptr<AsyncResult> CoreThread::addVoidToInternalQueue(std::function<void()> &commandCallback,
-                                                                    const Venus::Core::CoreThreadQueueFlags &flags) {
-        std::shared_ptr<AsyncResult> result;
+    CoreThreadLane CoreThread::_getLane(const CoreThreadQueueFlags &flags) {
+        if (flags.isSet(CTQF_Realtime)) {
+            if (flags.isSet(CTQF_Background)) VENUS_EXCEPT(InvalidOperationException,
+                                                           "A command cannot be both realtime and background.");
 
-        {
-            Lock lock(this->_commandQueueMutex);
-            result = this->_commandQueue->queueVoidCommand(std::move(commandCallback));
+            return CTL_Realtime;
         }
 
-        _commandReadySignal.notify_all();
+        return flags.isSet(CTQF_Background) ? CTL_Background : CTL_Normal;
+    }
 
-        if (flags.isSet(CTQF_BlockUntilComplete)) {
-            result->blockUntilComplete();
+    std::shared_ptr<AsyncResult>
+    CoreThread::_blockIfRequested(const std::shared_ptr<AsyncResultObject> &asyncResult,
+                                  const CoreThreadQueueFlags &flags) {
+        if (flags.isSet(CTQF_InternalQueue) && flags.isSet(CTQF_BlockUntilComplete)) {
+            asyncResult->blockUntilComplete();
         }
 
-        return result;
+        return asyncResult;
     }
 
-    std::shared_ptr<AsyncResult> CoreThread::queueReturningCommand(std::function<GenericObject()> commandCallback,
-                                                                   const CoreThreadQueueFlags &flags) {
-        if (flags.isSet(CTQF_InternalQueue))
-            return addReturningToInternalQueue(commandCallback, flags);
-        else
-            return this->getQueue()->queueReturningCommand(commandCallback);
-    }
+    void CoreThread::_notifyCommandReady() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
 
-    std::shared_ptr<AsyncResult>
-    CoreThread::addReturningToInternalQueue(std::function<GenericObject()> &commandCallback,
-                                            const CoreThreadQueueFlags &flags) {
-        std::shared_ptr<AsyncResult> result;
-        {
-            Lock lock(_commandQueueMutex);
-            result = _commandQueue->queueReturningCommand(std::move(commandCallback));
-        }
-        _commandReadySignal.notify_all();
+        // Only the producer that flips the flag signals, the rest see it cleared and return
+        if (!this->_coreThreadParked.load(std::memory_order_relaxed) ||
+            !this->_coreThreadParked.exchange(false, std::memory_order_relaxed))
+            return;
 
-        if (flags.isSet(CTQF_BlockUntilComplete)) {
-            result->blockUntilComplete();
-        }
+        // Taking the lock guarantees the core thread is either already waiting or has yet to check the queue
+        { Lock lock(this->_commandReadyCondition); }
 
-        return result;
+        this->_commandReadySignal.notify_one();
     }
 
     std::shared_ptr<CommandQueue<CommandQueueUnSynced>> CoreThread::getQueue() {
@@ -163,16 +232,7 @@ namespace Venus::Core {
     }
 
     void CoreThread::submit() {
-        Lock submitLock(this->_submitMutex);
-
-        auto queue = this->getQueue();
-
-        uint32_t callbackId;
-        queue->genCallbackId(callbackId);
-
-        this->_submitCommandQueue(queue);
-
-        this->_commandReadySignal.notify_all();
+        this->_submitCommandQueue(this->getQueue());
     }
 
     void CoreThread::submitAll() {
@@ -184,6 +244,9 @@ namespace Venus::Core {
         for (const auto &q : this->_allQueues) {
             auto queue = q.lock();
 
+            if (queue == nullptr)
+                continue;
+
             if (queue->isMain)
                 mainQueue = q;
             else
@@ -193,17 +256,104 @@ namespace Venus::Core {
         // Do main threads work last
         if (!mainQueue.expired())
             this->_submitCommandQueue(mainQueue.lock()->queue);
-
-        this->_commandReadySignal.notify_all();
     }
 
     void CoreThread::_submitCommandQueue(const std::shared_ptr<CommandQueue<CommandQueueUnSynced>> &queue) {
-        this->queueCommand([queue]() {
-            auto commands = queue->flushQueue();
-            queue->playBack(commands);
+        if (queue->isEmpty())
+            return;
+
+        // The filled buffer is detached on the submitting thread, the core thread only ever sees the pointer
+        CommandBuffer *buffer = queue->flushQueue();
+
+        this->queueCommand(DiscardResult, [this, queue, buffer]() {
+            this->_playBackBuffer(queue, buffer, nullptr);
         }, CTQF_InternalQueue);
     }
 
+    void CoreThread::_playBackBuffer(const std::shared_ptr<CommandQueue<CommandQueueUnSynced>> &queue,
+                                     CommandBuffer *buffer, const std::shared_ptr<AsyncResultObject> &fence) {
+        if (buffer != nullptr && !queue->playBack(buffer, this->_iterationDeadline)) {
+            this->_commandQueue->requeueFront(QueuedCommand::create([this, queue, buffer, fence]() {
+                this->_playBackBuffer(queue, buffer, fence);
+            }));
+
+            return;
+        }
+
+        if (fence != nullptr)
+            fence->_markAsComplete();
+    }
+
+    std::shared_ptr<AsyncResult> CoreThread::submitFrame() {
+        THROW_IF_CORE_THREAD
+
+        Lock lock(this->_frameMutex);
+
+        while (!this->_frameFences.empty() && this->_frameFences.front()->hasCompleted())
+            this->_frameFences.pop_front();
+
+        // Throttle the caller so it never runs more than the configured number of frames ahead
+        while (this->_frameFences.size() >= this->_framesInFlight) {
+            this->_frameFences.front()->blockUntilComplete();
+            this->_frameFences.pop_front();
+        }
+
+        auto queue = this->getQueue();
+        CommandBuffer *buffer = queue->isEmpty() ? nullptr : queue->flushQueue();
+
+        auto fence = std::make_shared<AsyncResultObject>();
+        this->queueCommand(DiscardResult, [this, queue, buffer, fence]() {
+            this->_playBackBuffer(queue, buffer, fence);
+        }, CTQF_InternalQueue);
+
+        this->_frameFences.push_back(fence);
+        ++this->_frameIndex;
+
+        return fence;
+    }
+
+    void CoreThread::waitForFrames() {
+        THROW_IF_CORE_THREAD
+
+        Lock lock(this->_frameMutex);
+
+        while (!this->_frameFences.empty()) {
+            this->_frameFences.front()->blockUntilComplete();
+            this->_frameFences.pop_front();
+        }
+    }
+
+    void CoreThread::setFramesInFlight(uint32_t framesInFlight) {
+        if (framesInFlight == 0) VENUS_EXCEPT(InvalidOperationException, "At least one frame must be allowed in flight.")
+
+        Lock lock(this->_frameMutex);
+        this->_framesInFlight = framesInFlight;
+    }
+
+    uint32_t CoreThread::getFramesInFlight() {
+        Lock lock(this->_frameMutex);
+        return this->_framesInFlight;
+    }
+
+    uint64_t CoreThread::getFrameIndex() {
+        Lock lock(this->_frameMutex);
+        return this->_frameIndex;
+    }
+
+    void CoreThread::setPlaybackBudget(std::chrono::microseconds budget) {
+        if (budget.count() < 0) VENUS_EXCEPT(InvalidOperationException, "The playback budget cannot be negative.")
+
+        this->_playbackBudget.store(budget, std::memory_order_relaxed);
+    }
+
+    std::chrono::microseconds CoreThread::getPlaybackBudget() {
+        return this->_playbackBudget.load(std::memory_order_relaxed);
+    }
+
+    CommandLaneStats CoreThread::getLaneStats(CoreThreadLane lane) {
+        return this->_commandQueue->getStats(lane);
+    }
+
     std::shared_ptr<CoreThread> getCoreThread() {
         return CoreThread::instance();
     }
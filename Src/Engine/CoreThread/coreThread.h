@@ -8,18 +8,39 @@
 #include <Error/venusExceptions.h>
 #include <Threading/threading.h>
 #include <Threading/asyncResultImpl.h>
+#include <Threading/typedAsyncResult.h>
 #include <PlatformDefines.h>
 #include <Helpers/flags.h>
 #include <memory>
+#include <chrono>
+#include <coroutine>
+#include <type_traits>
 #include <Module.h>
 #include "commandQueue.h"
+#include "priorityCommandQueue.h"
 #include "coreThreadQueueFlag.h"
+#include "queuedCommand.h"
 
 namespace Venus::Core {
 
     using namespace Utility::Threading;
     typedef Flags<CoreThreadQueueFlag> CoreThreadQueueFlags;
 
+    /** How long the core thread spins waiting for commands before it parks */
+    static constexpr std::chrono::microseconds CORE_THREAD_SPIN_DURATION{50};
+
+    /** How long the core thread may stay parked before it lends its core to the thread pool */
+    static constexpr std::chrono::milliseconds CORE_THREAD_LONG_SLEEP{2};
+
+    /** Default number of submitted frames the core thread may have outstanding */
+    static constexpr uint32_t CORE_THREAD_DEFAULT_FRAMES_IN_FLIGHT = 2;
+
+    /**
+     * Default time the core thread spends playing back commands per iteration before it defers the rest, changed with
+     * CoreThread::setPlaybackBudget()
+     */
+    static constexpr std::chrono::milliseconds CORE_THREAD_DEFAULT_PLAYBACK_BUDGET{4};
+
     FLAGS_OPERATORS(CoreThreadQueueFlag);
 
     /**
@@ -55,37 +76,211 @@ namespace Venus::Core {
          *
          * @param[in]	commandCallback		Command to queue.
          * @param[in]	flags				Flags that further control command submission.
+         * @param[in]	deadline			(optional) When the command should have executed by. Only relevant
+         *									for internal queue commands.
          *
          * @see		CommandQueue::queue()
          * @note	Thread safe
          */
+        template<typename CommandCallback>
         std::shared_ptr<AsyncResult>
-        queueCommand(std::function<void()> commandCallback, const CoreThreadQueueFlags &flags = CTQF_Default);
+        queueCommand(CommandCallback &&commandCallback, const CoreThreadQueueFlags &flags = CTQF_Default,
+                     CommandTimePoint deadline = NO_COMMAND_DEADLINE) {
+            auto asyncResult = std::make_shared<AsyncResultObject>();
+            this->_queueCommand(QueuedCommand::create(std::forward<CommandCallback>(commandCallback), asyncResult),
+                                flags, deadline);
+
+            return this->_blockIfRequested(asyncResult, flags);
+        }
 
         /**
-         * Queues a new command that will be added to the global command queue.
+         * Queues a new fire-and-forget command that will be added to the global command queue. No AsyncResult is
+         * created, so a command whose captures fit inline is queued without any allocation.
          *
          * @param[in]	commandCallback		Command to queue.
          * @param[in]	flags				Flags that further control command submission.
+         * @param[in]	deadline			(optional) When the command should have executed by. Only relevant
+         *									for internal queue commands.
+         *
+         * @note	Thread safe
+         * @note	CTQF_BlockUntilComplete cannot be used since there is nothing to wait on.
+         */
+        template<typename CommandCallback>
+        void queueCommand(DiscardResultTag, CommandCallback &&commandCallback,
+                          const CoreThreadQueueFlags &flags = CTQF_Default,
+                          CommandTimePoint deadline = NO_COMMAND_DEADLINE) {
+            if (flags.isSet(CTQF_BlockUntilComplete)) {
+                VENUS_EXCEPT(InvalidOperationException, "Cannot block on a command queued with DiscardResult.");
+            }
+
+            this->_queueCommand(QueuedCommand::create(std::forward<CommandCallback>(commandCallback)), flags,
+                                deadline);
+        }
+
+        /**
+         * Queues a new command that will be added to the global command queue.
+         *
+         * @param[in]	commandCallback		Command to queue, its return value is stored in the AsyncResult.
+         * @param[in]	flags				Flags that further control command submission.
+         * @param[in]	deadline			(optional) When the command should have executed by. Only relevant
+         *									for internal queue commands.
          *
          * @see		CommandQueue::queueReturning()
          * @note	Thread safe
+         * @note	Kept for existing callers, the result is boxed in a GenericObject. Prefer
+         *			queueReturningCommand<ReturnType>().
+         */
+        template<typename CommandCallback>
+        std::shared_ptr<AsyncResult>
+        queueReturningCommand(CommandCallback &&commandCallback, const CoreThreadQueueFlags &flags = CTQF_Default,
+                              CommandTimePoint deadline = NO_COMMAND_DEADLINE) {
+            auto asyncResult = std::make_shared<AsyncResultObject>();
+            this->_queueCommand(
+                    QueuedCommand::createReturning(std::forward<CommandCallback>(commandCallback), asyncResult), flags,
+                    deadline);
+
+            return this->_blockIfRequested(asyncResult, flags);
+        }
+
+        /**
+         * Queues a new command that will be added to the global command queue. The value returned by the callback is
+         * stored inline in the returned TypedAsyncResult, so it is neither boxed nor copied and may be move-only.
+         *
+         * @tparam		ReturnType			Type returned by the callback, may be void.
+         * @param[in]	commandCallback		Command to queue.
+         * @param[in]	flags				Flags that further control command submission.
+         * @param[in]	deadline			(optional) When the command should have executed by. Only relevant
+         *									for internal queue commands.
+         *
+         * @note	Thread safe
+         * @note	Allocates only the result, the command is stored inline if its captures fit.
+         */
+        template<typename ReturnType, typename CommandCallback>
+        std::shared_ptr<TypedAsyncResult<ReturnType>>
+        queueReturningCommand(CommandCallback &&commandCallback, const CoreThreadQueueFlags &flags = CTQF_Default,
+                              CommandTimePoint deadline = NO_COMMAND_DEADLINE) {
+            static_assert(std::is_convertible_v<std::invoke_result_t<CommandCallback &>, ReturnType> ||
+                          std::is_void_v<ReturnType>, "The command must return a value convertible to ReturnType.");
+
+            auto asyncResult = std::make_shared<TypedAsyncResult<ReturnType>>();
+            this->_queueCommand(
+                    QueuedCommand::createReturning<ReturnType>(std::forward<CommandCallback>(commandCallback),
+                                                               asyncResult), flags, deadline);
+
+            if (flags.isSet(CTQF_InternalQueue) && flags.isSet(CTQF_BlockUntilComplete))
+                asyncResult->blockUntilComplete();
+
+            return asyncResult;
+        }
+
+        /** Awaitable that resumes the awaiting coroutine on the core thread */
+        class ScheduleAwaitable {
+        public:
+            ScheduleAwaitable(CoreThread &coreThread, const CoreThreadQueueFlags &flags)
+                    : _coreThread(coreThread),
+                      _flags(flags) {}
+
+            /** A coroutine already running on the core thread carries on without being queued */
+            bool await_ready() const {
+                return THREAD_CURRENT_ID == this->_coreThread.getThreadId();
+            }
+
+            void await_suspend(std::coroutine_handle<> coroutine) {
+                this->_coreThread.queueCommand(DiscardResult, [coroutine]() { coroutine.resume(); }, this->_flags);
+            }
+
+            void await_resume() const noexcept {}
+
+        private:
+            CoreThread &_coreThread;
+            CoreThreadQueueFlags _flags;
+        };
+
+        /**
+         * Returns an awaitable that moves the awaiting coroutine onto the core thread, use as
+         * `co_await getCoreThread()->schedule()`
+         *
+         * @param[in]	flags		Flags the resumption is queued with, CTQF_InternalQueue is always added. Use
+         *							CTQF_Realtime or CTQF_Background to pick a lane.
+         */
+        ScheduleAwaitable schedule(const CoreThreadQueueFlags &flags = CTQF_InternalQueue) {
+            if (flags.isSet(CTQF_BlockUntilComplete)) VENUS_EXCEPT(InvalidOperationException,
+                                                                   "A coroutine cannot block on its own resumption.")
+
+            return ScheduleAwaitable(*this, flags | CTQF_InternalQueue);
+        }
+
+        /**
+         * Records a typed command packet into the calling thread's command buffer. Packets are copied into a linear
+         * byte stream and dispatched through CommandPacketTable, so they execute without any type erased call or
+         * allocation. They play back in order with closures queued on the same thread once submit() is called.
+         *
+         * @param[in]	packet		Packet to record, its type must be registered with CommandPacketTable.
+         *
+         * @note	Thread safe
          */
-        std::shared_ptr<AsyncResult> queueReturningCommand(std::function<GenericObject()> commandCallback,
-                                                           const CoreThreadQueueFlags &flags = CTQF_Default);
+        template<typename Packet>
+        void queuePacket(const Packet &packet) {
+            this->getQueue()->queuePacket(packet);
+        }
 
         /**
          * Submits the commands from all queues and starts executing them on the core thread.
-         * @note If called with having previously called queueCommand i.e the queue is empty, it might cause a deadlock
+         * @note Queues owned by other threads are flushed from the calling thread, so those threads must not be
+         * queueing commands at the same time. Call from the core thread or while the owners are idle.
          */
         void submitAll();
 
         /**
          * Submits the commands from the current thread's queue and starts executing them on the core thread.
-         * @note If called with having previously called queueCommand i.e the queue is empty, it might cause a deadlock
+         * @note Swaps the thread's recording buffer and publishes the filled one, it neither copies nor allocates
          */
         void submit();
 
+        /**
+         * Ends the calling thread's frame. Everything it queued since the previous frame is published to the core
+         * thread as a single unit, so the caller can record the next frame while the core thread plays this one back.
+         *
+         * @note Blocks only if the configured number of frames are already in flight, until the oldest completes.
+         * @note Must not be called from the core thread.
+         * @return A fence that completes once the core thread has played back the frame
+         */
+        std::shared_ptr<AsyncResult> submitFrame();
+
+        /** Blocks until every submitted frame has been played back */
+        void waitForFrames();
+
+        /**
+         * Sets how many submitted frames may be outstanding before submitFrame() blocks
+         * @param framesInFlight At least one, one means frame N is recorded while frame N - 1 plays back
+         */
+        void setFramesInFlight(uint32_t framesInFlight);
+
+        /** Returns how many submitted frames may be outstanding before submitFrame() blocks */
+        uint32_t getFramesInFlight();
+
+        /** Returns the number of frames submitted so far */
+        uint64_t getFrameIndex();
+
+        /**
+         * Sets how long the core thread plays back commands per loop iteration. Once the budget is exhausted the
+         * iteration ends, and a submitted command buffer that is not finished is resumed in a later iteration, after
+         * any realtime commands queued in the meantime. A single long command is never interrupted.
+         *
+         * @param budget The budget of an iteration, zero plays back every pending command in one iteration
+         * @note Thread safe, takes effect from the next iteration
+         */
+        void setPlaybackBudget(std::chrono::microseconds budget);
+
+        /** Returns how long the core thread plays back commands per loop iteration, zero if unlimited */
+        std::chrono::microseconds getPlaybackBudget();
+
+        /**
+         * Returns the depth, wait time and missed deadline counters of one of the internal queue's lanes
+         * @note Thread safe
+         */
+        CommandLaneStats getLaneStats(CoreThreadLane lane);
+
         /** Initialises the core thread*/
         void ignition() override;
 
@@ -94,14 +289,23 @@ namespace Venus::Core {
         ThreadId _workerThread{};
 
         bool _shutdownCoreThread{false};
+        std::atomic_bool _coreThreadParked{false};
+        std::chrono::steady_clock::duration _lastParkDuration{0};
 
-        std::shared_ptr<CommandQueue<CommandQueueSync>> _commandQueue;
+        std::atomic<std::chrono::microseconds> _playbackBudget{CORE_THREAD_DEFAULT_PLAYBACK_BUDGET};
+        CommandTimePoint _iterationDeadline{NO_COMMAND_DEADLINE};
+
+        std::shared_ptr<PriorityCommandQueue> _commandQueue;
         std::vector<std::weak_ptr<ThreadQueueContainer>> _allQueues;
 
-        Mutex _commandQueueMutex;
+        DeQueue<std::shared_ptr<AsyncResult>> _frameFences;
+        uint32_t _framesInFlight{CORE_THREAD_DEFAULT_FRAMES_IN_FLIGHT};
+        uint64_t _frameIndex{0};
+
         Mutex _commandReadyCondition;
         Mutex _submitMutex;
         Mutex _startUpMutex;
+        Mutex _frameMutex;
 
         Signal _commandReadySignal;
 
@@ -112,25 +316,59 @@ namespace Venus::Core {
         std::shared_ptr<CommandQueue<CommandQueueUnSynced>> getQueue();
 
         /**
-         * Submits all the commands from the provided command queue to the internal command queue.
+         * Flushes the provided command queue and publishes its filled buffer on the internal command queue.
          */
         void _submitCommandQueue(const std::shared_ptr<CommandQueue<CommandQueueUnSynced>>& queue);
 
         /**
-         * Adds the callback to the internal core queue
-         * @param commandCallback The the command
+         * Plays back a submitted buffer until the iteration's budget is exhausted, then requeues the remainder at the
+         * front of the lane it is executing on
+         * @param queue The queue that flushed the buffer
+         * @param buffer The buffer, nothing is played back if null
+         * @param fence (optional) Marked as complete once the whole buffer has been played back
+         */
+        void _playBackBuffer(const std::shared_ptr<CommandQueue<CommandQueueUnSynced>> &queue, CommandBuffer *buffer,
+                             const std::shared_ptr<AsyncResultObject> &fence);
+
+        /**
+         * Adds the command to either the internal core queue or the calling thread's queue
+         * @param command The the command
          * @param flags Flags used to specify how the command should be handled
-         * @return Async Result
+         * @param deadline When the command should have executed by
          */
-        std::shared_ptr<AsyncResult>
-        addVoidToInternalQueue(std::function<void()> &commandCallback, const Venus::Core::CoreThreadQueueFlags &flags);
+        void _queueCommand(QueuedCommand &&command, const CoreThreadQueueFlags &flags, CommandTimePoint deadline);
+
+        /** Returns the internal queue lane selected by the priority flags */
+        static CoreThreadLane _getLane(const CoreThreadQueueFlags &flags);
+
+        /** Blocks until the command has executed if it was queued on the internal queue with CTQF_BlockUntilComplete */
+        static std::shared_ptr<AsyncResult>
+        _blockIfRequested(const std::shared_ptr<AsyncResultObject> &asyncResult, const CoreThreadQueueFlags &flags);
+
+        /**
+         * Wakes the core thread if it is parked waiting for commands. Only the producer that observes the parked core
+         * thread signals it, any other producer publishing while it wakes up does not touch the mutex or signal.
+         * @note Must be called after the command has been published to the internal queue
+         */
+        void _notifyCommandReady();
+
+        /**
+         * Spins, backing off from CPU pause hints to yielding, until a command is published or
+         * CORE_THREAD_SPIN_DURATION elapses
+         * @note Does not spin on single core machines
+         * @return True if a command was published
+         */
+        bool _spinForCommands();
+
+        /**
+         * Parks the core thread until a command is published. The thread pool quota is only raised while parks last
+         * longer than CORE_THREAD_LONG_SLEEP, short sleeps never touch the pool.
+         * @return False if the core thread was shut down while parked
+         */
+        bool _parkUntilCommandReady();
 
         /** Sets the core thread priority for PThread implementation*/
         void configurePThread();
-
-        std::shared_ptr<AsyncResult>
-        addReturningToInternalQueue(std::function<GenericObject()> &commandCallback,
-                                    const CoreThreadQueueFlags &flags);
     };
 
     /** Returns global CoreThread instance*/
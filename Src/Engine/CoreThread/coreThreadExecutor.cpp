@@ -0,0 +1,22 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "coreThreadExecutor.h"
+
+namespace Venus::Core {
+    CoreThreadExecutor::CoreThreadExecutor(const CoreThreadQueueFlags &flags)
+            : _flags(flags | CTQF_InternalQueue) {
+        if (this->_flags.isSet(CTQF_BlockUntilComplete)) VENUS_EXCEPT(InvalidOperationException,
+                                                                      "An executor cannot block on the work it queues.")
+    }
+
+    CoreThreadExecutor &CoreThreadExecutor::instance() {
+        static CoreThreadExecutor executor;
+        return executor;
+    }
+
+    void CoreThreadExecutor::execute(Work &&work) {
+        getCoreThread()->queueCommand(DiscardResult, std::move(work), this->_flags);
+    }
+}
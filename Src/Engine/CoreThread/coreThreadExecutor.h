@@ -0,0 +1,38 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_CORETHREADEXECUTOR_H
+#define VENUS_CORETHREADEXECUTOR_H
+
+#include <Threading/executor.h>
+#include "coreThread.h"
+
+namespace Venus::Core {
+    /**
+     * Queues work as fire-and-forget commands on the core thread's internal queue.
+     *
+     * @note Executors are referenced by the results they are used with, one created with custom flags must outlive
+     * them
+     */
+    class CoreThreadExecutor final : public Utility::Threading::Executor {
+    public:
+        /**
+         * Constructor
+         * @param flags Flags the work is queued with, CTQF_InternalQueue is always added. Use CTQF_Realtime or
+         * CTQF_Background to pick a lane.
+         */
+        explicit CoreThreadExecutor(const CoreThreadQueueFlags &flags = CTQF_InternalQueue);
+
+        /** Returns the global core thread executor, which queues work on the normal lane */
+        static CoreThreadExecutor &instance();
+
+        /** @copydoc Executor::execute */
+        void execute(Work &&work) override;
+
+    private:
+        CoreThreadQueueFlags _flags;
+    };
+}
+
+#endif //VENUS_CORETHREADEXECUTOR_H
@@ -23,7 +23,29 @@ enum CoreThreadQueueFlag {
      * internal queue commands since contents of the normal queue won't be submitted to the core thread until the
      * CoreThread::submit() call.
      */
-    CTQF_BlockUntilComplete = 1 << 1
+    CTQF_BlockUntilComplete = 1 << 1,
+    /**
+     * Executes the command ahead of any normal or background work, e.g. window events and present. Only relevant for
+     * internal queue commands.
+     */
+    CTQF_Realtime = 1 << 2,
+    /**
+     * Executes the command only once no realtime or normal work is pending, e.g. bulk resource uploads. Only relevant
+     * for internal queue commands.
+     */
+    CTQF_Background = 1 << 3
+};
+
+/** Priority lanes of the core thread's internal queue, in the order they are drained. */
+enum CoreThreadLane {
+    /** Commands queued with CTQF_Realtime */
+    CTL_Realtime = 0,
+    /** Commands queued without a priority flag */
+    CTL_Normal = 1,
+    /** Commands queued with CTQF_Background */
+    CTL_Background = 2,
+    /** Number of lanes */
+    CTL_Count = 3
 };
 
 
@@ -0,0 +1,214 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "priorityCommandQueue.h"
+#include <algorithm>
+#include <thread>
+
+namespace Venus::Core {
+    namespace {
+        /** Orders the deadline heap so the earliest deadline is at the front */
+        template<typename DeadlineCommand>
+        bool laterDeadline(const DeadlineCommand &left, const DeadlineCommand &right) {
+            return left.pending.deadline > right.pending.deadline;
+        }
+    }
+
+    PriorityCommandQueue::PriorityCommandQueue(ThreadId consumerThreadId)
+            : _consumerThreadId(consumerThreadId) {
+        for (auto &lane : this->_lanes)
+            lane = std::make_unique<CommandQueue<CommandQueueLockFree>>(consumerThreadId);
+    }
+
+    void PriorityCommandQueue::queueCommand(QueuedCommand &&command, CoreThreadLane lane, CommandTimePoint deadline) {
+        PendingCommand pending = CommandQueue<CommandQueueLockFree>::createPending(std::move(command), deadline);
+
+        while (!this->_lanes[lane]->tryPublish(pending)) {
+            // Drained through the lanes rather than the full ring alone, so realtime work still runs first
+            if (THREAD_CURRENT_ID == this->_consumerThreadId)
+                this->playBackPending();
+            else
+                std::this_thread::yield();
+        }
+
+        // Published after the command, so a consumer observing the count also observes the command
+        if (deadline != NO_COMMAND_DEADLINE)
+            this->_publishedDeadlines.fetch_add(1, std::memory_order_release);
+    }
+
+    uint32_t PriorityCommandQueue::playBackPending(CommandTimePoint until) {
+        uint32_t executed = 0;
+
+        while (this->executeNext()) {
+            ++executed;
+
+            if (this->_budgetExhausted) {
+                this->_budgetExhausted = false;
+                break;
+            }
+
+            // Reading the clock costs about as much as a small command, so the budget is only checked periodically
+            if (executed % COMMAND_BUDGET_CHECK_INTERVAL == 0 && until != NO_COMMAND_DEADLINE &&
+                CommandClock::now() >= until)
+                break;
+        }
+
+        return executed;
+    }
+
+    bool PriorityCommandQueue::executeNext() {
+        if (this->_executeStaged(CTL_Realtime))
+            return true;
+
+        if (auto pending = this->_lanes[CTL_Realtime]->tryPop()) {
+            this->_execute(*pending, CTL_Realtime);
+            return true;
+        }
+
+        if (this->_publishedDeadlines.load(std::memory_order_acquire) != this->_seenDeadlines) {
+            this->_stage(CTL_Normal);
+            this->_stage(CTL_Background);
+        }
+
+        if (!this->_deadlineCommands.empty() &&
+            this->_deadlineCommands.front().pending.deadline <= CommandClock::now() + COMMAND_DEADLINE_PROMOTION_WINDOW) {
+            this->_executeEarliestDeadline();
+            return true;
+        }
+
+        for (auto lane : {CTL_Normal, CTL_Background}) {
+            if (this->_executeStaged(lane))
+                return true;
+
+            // Nothing is staged ahead of the ring, so executing straight from it keeps the lane's order
+            if (auto pending = this->_lanes[lane]->tryPop()) {
+                if (pending->hasDeadline())
+                    ++this->_seenDeadlines;
+
+                this->_execute(*pending, lane);
+                return true;
+            }
+        }
+
+        // Nothing else is pending, so commands with distant deadlines may as well run now
+        if (!this->_deadlineCommands.empty()) {
+            this->_executeEarliestDeadline();
+            return true;
+        }
+
+        return false;
+    }
+
+    void PriorityCommandQueue::requeueFront(QueuedCommand &&command) {
+        this->_staged[this->_executingLane].push_front(PendingCommand{std::move(command), {}, NO_COMMAND_DEADLINE});
+        this->_counters[this->_executingLane].staged.fetch_add(1, std::memory_order_relaxed);
+        this->_budgetExhausted = true;
+    }
+
+    bool PriorityCommandQueue::isEmpty() {
+        for (uint32_t lane = 0; lane < CTL_Count; ++lane) {
+            if (!this->_lanes[lane]->isEmpty() || this->_counters[lane].staged.load(std::memory_order_relaxed) > 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    CommandLaneStats PriorityCommandQueue::getStats(CoreThreadLane lane) {
+        auto &counters = this->_counters[lane];
+
+        CommandLaneStats stats;
+        stats.depth = this->_lanes[lane]->size() + counters.staged.load(std::memory_order_relaxed);
+        stats.executedCommands = counters.executed.load(std::memory_order_relaxed);
+        stats.maxWaitTime = std::chrono::nanoseconds(counters.maxWaitNanoseconds.load(std::memory_order_relaxed));
+        stats.missedDeadlines = counters.missedDeadlines.load(std::memory_order_relaxed);
+
+        uint64_t sampled = counters.sampled.load(std::memory_order_relaxed);
+        if (sampled > 0) {
+            stats.averageWaitTime = std::chrono::nanoseconds(
+                    counters.totalWaitNanoseconds.load(std::memory_order_relaxed) / sampled);
+        }
+
+        return stats;
+    }
+
+    void PriorityCommandQueue::_stage(CoreThreadLane lane) {
+        while (auto pending = this->_lanes[lane]->tryPop())
+            this->_stage(std::move(*pending), lane);
+    }
+
+    void PriorityCommandQueue::_stage(PendingCommand &&pending, CoreThreadLane lane) {
+        if (pending.hasDeadline()) {
+            ++this->_seenDeadlines;
+
+            this->_deadlineCommands.push_back(DeadlineCommand{std::move(pending), lane});
+            std::push_heap(this->_deadlineCommands.begin(), this->_deadlineCommands.end(),
+                           laterDeadline<DeadlineCommand>);
+        } else {
+            this->_staged[lane].push_back(std::move(pending));
+        }
+
+        this->_counters[lane].staged.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool PriorityCommandQueue::_executeStaged(CoreThreadLane lane) {
+        auto &staged = this->_staged[lane];
+
+        if (staged.empty())
+            return false;
+
+        PendingCommand pending = std::move(staged.front());
+        staged.pop_front();
+        this->_counters[lane].staged.fetch_sub(1, std::memory_order_relaxed);
+
+        this->_execute(pending, lane);
+        return true;
+    }
+
+    void PriorityCommandQueue::_execute(PendingCommand &pending, CoreThreadLane lane) {
+        auto &counters = this->_counters[lane];
+
+        // A command filling a ring plays back the other commands from within, the lane is restored once they ran
+        CoreThreadLane previousLane = this->_executingLane;
+        this->_executingLane = lane;
+
+        // Only the consumer writes the counters, so plain read-modify-write is enough
+        counters.executed.store(counters.executed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        if (pending.isTimeStamped() || pending.hasDeadline()) {
+            auto now = CommandClock::now();
+
+            if (pending.isTimeStamped()) {
+                auto waited = static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(now - pending.queuedAt).count());
+
+                counters.sampled.store(counters.sampled.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                counters.totalWaitNanoseconds.store(
+                        counters.totalWaitNanoseconds.load(std::memory_order_relaxed) + waited,
+                        std::memory_order_relaxed);
+
+                if (waited > counters.maxWaitNanoseconds.load(std::memory_order_relaxed))
+                    counters.maxWaitNanoseconds.store(waited, std::memory_order_relaxed);
+            }
+
+            if (now > pending.deadline)
+                counters.missedDeadlines.store(counters.missedDeadlines.load(std::memory_order_relaxed) + 1,
+                                               std::memory_order_relaxed);
+        }
+
+        pending.command.execute();
+        this->_executingLane = previousLane;
+    }
+
+    void PriorityCommandQueue::_executeEarliestDeadline() {
+        std::pop_heap(this->_deadlineCommands.begin(), this->_deadlineCommands.end(),
+                      laterDeadline<DeadlineCommand>);
+
+        DeadlineCommand deadlineCommand = std::move(this->_deadlineCommands.back());
+        this->_deadlineCommands.pop_back();
+        this->_counters[deadlineCommand.lane].staged.fetch_sub(1, std::memory_order_relaxed);
+
+        this->_execute(deadlineCommand.pending, deadlineCommand.lane);
+    }
+}
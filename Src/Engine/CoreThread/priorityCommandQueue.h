@@ -0,0 +1,154 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_PRIORITYCOMMANDQUEUE_H
+#define VENUS_PRIORITYCOMMANDQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "commandQueue.h"
+#include "coreThreadQueueFlag.h"
+
+namespace Venus::Core {
+    /** How close to its deadline a normal or background command gets before it is promoted ahead of its lane */
+    static constexpr std::chrono::microseconds COMMAND_DEADLINE_PROMOTION_WINDOW{1000};
+
+    /** Snapshot of the counters of one of the core thread's lanes */
+    struct CommandLaneStats {
+        /** Number of commands waiting in the lane */
+        uint32_t depth{0};
+
+        /** Number of commands executed from the lane */
+        uint64_t executedCommands{0};
+
+        /** Average time commands waited between being queued and starting to execute, over the sampled commands */
+        std::chrono::nanoseconds averageWaitTime{0};
+
+        /** Longest time a sampled command waited between being queued and starting to execute */
+        std::chrono::nanoseconds maxWaitTime{0};
+
+        /** Number of commands that started executing after their deadline */
+        uint64_t missedDeadlines{0};
+    };
+
+    /**
+     * The core thread's internal queue, split into a lock-free ring per CoreThreadLane.
+     *
+     * Realtime commands always run first. Once a command with a deadline is published, normal and background
+     * commands are staged on the consumer side, which lets a command nearing its deadline be promoted ahead of the
+     * rest of the lanes. Without deadlines in flight commands are executed straight out of the rings. Commands
+     * without a deadline keep their FIFO order within their lane. A command that runs out of time budget can requeue
+     * its remainder at the front of its lane, which is staged ahead of the ring.
+     *
+     * @note Any thread may queue commands, only the consumer thread may play them back.
+     * @note Background commands only run while no realtime or normal work is pending, give them a deadline if they
+     * must not starve.
+     */
+    class PriorityCommandQueue {
+    public:
+        /**
+         * Constructor
+         * @param consumerThreadId The thread identifier of the only thread allowed to play back the queue
+         */
+        explicit PriorityCommandQueue(ThreadId consumerThreadId);
+
+        /**
+         * Publishes the command to a lane. If the lane's ring is full the consumer plays back every lane in priority
+         * order to make room, while any other thread yields until the consumer does.
+         * @param command The command to be queued for execution
+         * @param lane The lane the command is queued on
+         * @param deadline When the command should have executed by
+         */
+        void queueCommand(QueuedCommand &&command, CoreThreadLane lane,
+                          CommandTimePoint deadline = NO_COMMAND_DEADLINE);
+
+        /**
+         * Executes commands in priority order until every lane is empty or the time budget is exhausted
+         * @param until When to stop executing commands, the clock is read every COMMAND_BUDGET_CHECK_INTERVAL commands
+         * @note Must be called from the consumer thread
+         * @return The number of commands executed
+         */
+        uint32_t playBackPending(CommandTimePoint until = NO_COMMAND_DEADLINE);
+
+        /**
+         * Executes the highest priority command
+         * @note Must be called from the consumer thread
+         * @return False if every lane was empty
+         */
+        bool executeNext();
+
+        /**
+         * Queues the remainder of the executing command at the front of its lane, so it resumes ahead of everything
+         * queued after it while higher priority lanes still get to run first. The command is expected to have run
+         * out of budget, so playBackPending() returns once it finishes.
+         * @param command The command that continues the one currently executing
+         * @note Must be called from a command being played back by the consumer thread
+         */
+        void requeueFront(QueuedCommand &&command);
+
+        /**
+         * Returns true if no commands are waiting in any lane
+         * @note Exact when called by the consumer, a snapshot when called from any other thread
+         */
+        bool isEmpty();
+
+        /** Returns a snapshot of the lane's counters, safe to call from any thread */
+        CommandLaneStats getStats(CoreThreadLane lane);
+
+    private:
+        /** Counters written by the consumer and read by anyone */
+        struct LaneCounters {
+            std::atomic<uint32_t> staged{0};
+            std::atomic<uint64_t> executed{0};
+            std::atomic<uint64_t> sampled{0};
+            std::atomic<uint64_t> totalWaitNanoseconds{0};
+            std::atomic<uint64_t> maxWaitNanoseconds{0};
+            std::atomic<uint64_t> missedDeadlines{0};
+        };
+
+        /** A staged command with a deadline, kept in a min heap ordered by deadline */
+        struct DeadlineCommand {
+            PendingCommand pending;
+            CoreThreadLane lane;
+        };
+
+        /** Moves every command published to the lane's ring into the consumer side staging area */
+        void _stage(CoreThreadLane lane);
+
+        /** Stages a single command popped from the lane's ring */
+        void _stage(PendingCommand &&pending, CoreThreadLane lane);
+
+        /** Executes the oldest staged command of the lane, returns false if nothing is staged */
+        bool _executeStaged(CoreThreadLane lane);
+
+        /** Executes the command and updates the lane's counters */
+        void _execute(PendingCommand &pending, CoreThreadLane lane);
+
+        /** Executes the staged command with the earliest deadline */
+        void _executeEarliestDeadline();
+
+        std::array<std::unique_ptr<CommandQueue<CommandQueueLockFree>>, CTL_Count> _lanes;
+        std::array<DeQueue<PendingCommand>, CTL_Count> _staged;
+        std::vector<DeadlineCommand> _deadlineCommands;
+
+        /** Deadline commands published by producers and seen by the consumer, staging only runs while they differ */
+        std::atomic<uint64_t> _publishedDeadlines{0};
+        uint64_t _seenDeadlines{0};
+
+        /** Lane of the command being executed, continuations are requeued on it */
+        CoreThreadLane _executingLane{CTL_Normal};
+
+        /** Set when a command requeued its remainder, ends the current playBackPending() call */
+        bool _budgetExhausted{false};
+
+        std::array<LaneCounters, CTL_Count> _counters;
+
+        ThreadId _consumerThreadId;
+    };
+}
+
+#endif //VENUS_PRIORITYCOMMANDQUEUE_H
@@ -5,57 +5,127 @@
 #ifndef VENUS_QUEUEDCOMMAND_H
 #define VENUS_QUEUEDCOMMAND_H
 
+#include <chrono>
 #include <functional>
 #include <Threading/asyncResultImpl.h>
+#include <Threading/typedAsyncResult.h>
+#include <Helpers/inlineFunction.h>
 #include <memory>
 #include <utility>
 
 namespace Venus::Core {
     using namespace Utility::Threading;
 
+    /** Clock used to time stamp commands and express their deadlines */
+    typedef std::chrono::steady_clock CommandClock;
+
+    /** A point in time on the CommandClock */
+    typedef CommandClock::time_point CommandTimePoint;
+
+    /** Deadline of commands that do not have one */
+    static constexpr CommandTimePoint NO_COMMAND_DEADLINE = CommandTimePoint::max();
+
+    /** Number of commands executed between two reads of the CommandClock while playing back against a time budget */
+    static constexpr uint32_t COMMAND_BUDGET_CHECK_INTERVAL = 16;
+
+    /** Number of bytes of captured state a command can hold before its callback has to be heap allocated */
+    static constexpr size_t QUEUED_COMMAND_INLINE_SIZE = 48;
+
+    /** Tag selecting the fire-and-forget queueCommand overloads, which neither create nor return an AsyncResult */
+    struct DiscardResultTag {
+        explicit DiscardResultTag() = default;
+    };
+
+    /** @copydoc DiscardResultTag */
+    inline constexpr DiscardResultTag DiscardResult{};
+
     /**
      * Represents a single queued command in the command queue
      *
      * @note This command contains all the data it needs to be executed
+     * @note Commands are move-only, the callback is stored inline unless its captures exceed
+     * QUEUED_COMMAND_INLINE_SIZE bytes
      */
     struct QueuedCommand {
     public:
-        /** Constructor*/
-        QueuedCommand(std::function<void()> callback, std::shared_ptr<AsyncResultObject> asyncResult)
+        /** The callable executed by a command */
+        using Callback = InlineFunction<void(), QUEUED_COMMAND_INLINE_SIZE>;
 
-                : _callback{std::move(callback)},
-                  _asyncResult{std::move(asyncResult)} {}
+        /** Creates a command that does not report its completion */
+        template<typename CommandCallback>
+        static QueuedCommand create(CommandCallback &&callback) {
+            return QueuedCommand(Callback(std::forward<CommandCallback>(callback)));
+        }
 
-        /** Constructor */
-        QueuedCommand(std::function<GenericObject()> callback, std::shared_ptr<AsyncResultObject> asyncResult)
+        /** Creates a command that marks the async result as complete once the callback has executed */
+        template<typename CommandCallback>
+        static QueuedCommand create(CommandCallback &&callback, std::shared_ptr<AsyncResultObject> asyncResult) {
+            return QueuedCommand(Callback(
+                    [callback = std::forward<CommandCallback>(callback), asyncResult = std::move(asyncResult)]() mutable {
+                        callback();
+                        asyncResult->_markAsComplete();
+                    }));
+        }
 
-                : _callbackWithReturnValue(std::move(callback)),
-                  _returnsValue(true),
-                  _asyncResult{std::move(asyncResult)} {}
+        /** Creates a command whose callback's return value is stored in the async result */
+        template<typename CommandCallback>
+        static QueuedCommand
+        createReturning(CommandCallback &&callback, std::shared_ptr<AsyncResultObject> asyncResult) {
+            return QueuedCommand(Callback(
+                    [callback = std::forward<CommandCallback>(callback), asyncResult = std::move(asyncResult)]() mutable {
+                        GenericObject returnedValue = callback();
+                        asyncResult->_markAsCompleteWithValue(returnedValue);
+                    }));
+        }
+
+        /** Creates a command whose callback's return value is stored inline in the typed async result */
+        template<typename ReturnType, typename CommandCallback>
+        static QueuedCommand
+        createReturning(CommandCallback &&callback, std::shared_ptr<TypedAsyncResult<ReturnType>> asyncResult) {
+            return QueuedCommand(Callback(
+                    [callback = std::forward<CommandCallback>(callback), asyncResult = std::move(asyncResult)]() mutable {
+                        asyncResult->_completeWith(callback);
+                    }));
+        }
+
+        QueuedCommand(QueuedCommand &&) noexcept = default;
+
+        QueuedCommand &operator=(QueuedCommand &&) noexcept = default;
 
         /**
          * Executes the given this command
          */
         void execute() {
+            this->_callback();
+        }
+
+    private:
+        /** Constructor */
+        explicit QueuedCommand(Callback callback)
+                : _callback(std::move(callback)) {}
 
-            if (this->_returnsValue) {
-                GenericObject returnedValue = _callbackWithReturnValue();
-                this->_asyncResult->_markAsCompleteWithValue(returnedValue);
+        Callback _callback;
+    };
 
-                return;
-            }
+    /** A command waiting in one of the core thread's internal lanes */
+    struct PendingCommand {
+        QueuedCommand command;
 
-            _callback();
-            this->_asyncResult->_markAsComplete();
-        }
+        /** When the command was queued, used to measure how long it waited. Left at the epoch if not sampled */
+        CommandTimePoint queuedAt;
 
-    private:
-        std::function<void()> _callback{nullptr};
-        std::function<GenericObject()> _callbackWithReturnValue{nullptr};
+        /** When the command should have executed by, NO_COMMAND_DEADLINE if it has no deadline */
+        CommandTimePoint deadline;
 
-        bool _returnsValue{false};
+        /** Returns true if the command was queued with a deadline */
+        [[nodiscard]] bool hasDeadline() const {
+            return this->deadline != NO_COMMAND_DEADLINE;
+        }
 
-        std::shared_ptr<AsyncResultObject> _asyncResult{nullptr};
+        /** Returns true if the time the command was queued at was recorded */
+        [[nodiscard]] bool isTimeStamped() const {
+            return this->queuedAt != CommandTimePoint();
+        }
     };
 }
 
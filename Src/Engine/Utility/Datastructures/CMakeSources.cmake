@@ -1,6 +1,9 @@
 
 set(ENGINE_DATA_STRUCTURES_INC
         DataStructures/fibonacciHeap.h
+        DataStructures/mpscRingBuffer.h
+        DataStructures/chaseLevDeque.h
+        DataStructures/priorityBucketQueue.h
         )
 
 set(ENGINE_DATA_STRUCTURES_SRC
@@ -0,0 +1,168 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_CHASELEVDEQUE_H
+#define VENUS_CHASELEVDEQUE_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include "mpscRingBuffer.h"
+
+namespace Venus::Utility::DataStructures {
+    /** Number of items a new Chase-Lev deque has room for before it grows */
+    static constexpr uint32_t CHASE_LEV_DEQUE_INITIAL_CAPACITY = 256;
+
+    /**
+     * An unbounded, lock-free work stealing deque of pointers (Chase & Lev, "Dynamic Circular Work-Stealing Deque",
+     * using the memory orderings of Lê et al, "Correct and Efficient Work-Stealing for Weak Memory Models").
+     *
+     * @note Only the owning thread may push and pop, both work on the bottom of the deque so the owner sees its most
+     * recent work first. Any thread may steal, stealing takes the oldest item from the top.
+     * @note The deque never owns the pointed to items. Arrays replaced when the deque grows are kept until the deque
+     * is destroyed, as a thief may still be reading from one.
+     */
+    template<typename T>
+    class ChaseLevDeque {
+    public:
+        /**
+         * Constructor
+         * @param capacity The initial capacity, must be a power of two
+         */
+        explicit ChaseLevDeque(uint32_t capacity = CHASE_LEV_DEQUE_INITIAL_CAPACITY) {
+            assert(capacity >= 2 && (capacity & (capacity - 1)) == 0 && "Capacity must be a power of two");
+
+            this->_arrays.push_back(std::make_unique<Array>(capacity));
+            this->_array.store(this->_arrays.back().get(), std::memory_order_relaxed);
+        }
+
+        ChaseLevDeque(const ChaseLevDeque &) = delete;
+
+        ChaseLevDeque &operator=(const ChaseLevDeque &) = delete;
+
+        /**
+         * Pushes an item onto the bottom of the deque, growing it if it is full
+         * @note Must only be called by the owning thread
+         */
+        void push(T *item) {
+            int64_t bottom = this->_bottom.load(std::memory_order_relaxed);
+            int64_t top = this->_top.load(std::memory_order_acquire);
+            Array *array = this->_array.load(std::memory_order_relaxed);
+
+            if (bottom - top > static_cast<int64_t>(array->mask))
+                array = this->_grow(array, top, bottom);
+
+            array->put(bottom, item);
+            std::atomic_thread_fence(std::memory_order_release);
+            this->_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /**
+         * Pops the most recently pushed item from the bottom of the deque
+         * @note Must only be called by the owning thread
+         * @return The item, or nullptr if the deque is empty or a thief won the race for the last item
+         */
+        T *pop() {
+            int64_t bottom = this->_bottom.load(std::memory_order_relaxed) - 1;
+            Array *array = this->_array.load(std::memory_order_relaxed);
+
+            this->_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = this->_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                this->_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T *item = array->get(bottom);
+            if (top == bottom) {
+                // Last item, race any thieves for it
+                if (!this->_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                        std::memory_order_relaxed))
+                    item = nullptr;
+
+                this->_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return item;
+        }
+
+        /**
+         * Steals the oldest item from the top of the deque
+         * @note May be called from any thread
+         * @return The item, or nullptr if the deque is empty or another thread won the race for the item
+         */
+        T *steal() {
+            int64_t top = this->_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = this->_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return nullptr;
+
+            T *item = this->_array.load(std::memory_order_acquire)->get(top);
+            if (!this->_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed))
+                return nullptr;
+
+            return item;
+        }
+
+        /** Returns the approximate number of items in the deque */
+        [[nodiscard]] uint32_t size() const {
+            int64_t bottom = this->_bottom.load(std::memory_order_relaxed);
+            int64_t top = this->_top.load(std::memory_order_relaxed);
+
+            return bottom > top ? static_cast<uint32_t>(bottom - top) : 0;
+        }
+
+        /** Returns true if the deque appears empty */
+        [[nodiscard]] bool isEmpty() const {
+            return this->size() == 0;
+        }
+
+    private:
+        /** A power of two sized circular array of item pointers */
+        struct Array {
+            explicit Array(uint32_t capacity)
+                    : items(std::make_unique<std::atomic<T *>[]>(capacity)),
+                      mask(capacity - 1) {}
+
+            T *get(int64_t index) const {
+                return this->items[index & this->mask].load(std::memory_order_relaxed);
+            }
+
+            void put(int64_t index, T *item) {
+                this->items[index & this->mask].store(item, std::memory_order_relaxed);
+            }
+
+            const std::unique_ptr<std::atomic<T *>[]> items;
+            const uint64_t mask;
+        };
+
+        /** Replaces the array with one twice its size holding the items between top and bottom */
+        Array *_grow(Array *array, int64_t top, int64_t bottom) {
+            this->_arrays.push_back(std::make_unique<Array>(static_cast<uint32_t>(array->mask + 1) * 2));
+            Array *grown = this->_arrays.back().get();
+
+            for (int64_t i = top; i < bottom; ++i)
+                grown->put(i, array->get(i));
+
+            this->_array.store(grown, std::memory_order_release);
+            return grown;
+        }
+
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> _top{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> _bottom{0};
+        std::atomic<Array *> _array{nullptr};
+
+        /** Every array the deque has used, only touched by the owner */
+        std::vector<std::unique_ptr<Array>> _arrays;
+    };
+}
+
+#endif //VENUS_CHASELEVDEQUE_H
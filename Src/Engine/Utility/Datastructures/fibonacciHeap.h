@@ -5,8 +5,10 @@
 #ifndef VENUS_FIBONACCIHEAP_H
 #define VENUS_FIBONACCIHEAP_H
 
+#include <cmath>
 #include <functional>
 #include <list>
+#include <vector>
 
 namespace Venus::Utility::DataStructures {
     template<typename T>
@@ -85,6 +87,7 @@ namespace Venus::Utility::DataStructures {
                     _consolidate();
                 } else m_minNode = nullptr;
                 m_numOfNodes--;
+                delete min;
             }
         }
 
@@ -93,6 +96,9 @@ namespace Venus::Utility::DataStructures {
         }
 
     private:
+        /* Scratch space of _consolidate, kept so popping does not allocate */
+        std::vector<FibHeapNode<T> *> m_roots;
+        std::vector<FibHeapNode<T> *> m_degrees;
 
         FibHeapNode<T> *_create_node(T newNode, float newKey) {
             auto *node = new FibHeapNode<T>();
@@ -158,24 +164,24 @@ namespace Venus::Utility::DataStructures {
         }
 
         void _consolidate() {
-            int Dn = (int) (log2(m_numOfNodes) / log2(1.618));
-            auto **A = new FibHeapNode<T> *[Dn + 1];
+            // Roots are gathered first, linking changes the root list under a walk of it
+            std::vector<FibHeapNode<T> *> &roots = m_roots;
+            roots.clear();
 
-            for (int i = 0; i < Dn + 1; i++)
-                A[i] = nullptr;
+            FibHeapNode<T> *iter = m_minNode;
+            do {
+                roots.push_back(iter);
+                iter = iter->right;
+            } while (iter != m_minNode);
+
+            std::vector<FibHeapNode<T> *> &A = m_degrees;
+            A.assign((size_t) (log2(m_numOfNodes + 1) / log2(1.618)) + 2, nullptr);
 
-            FibHeapNode<T> *x = m_minNode;
-            bool breakFlag = false;
-            while (true) {
+            for (FibHeapNode<T> *x : roots) {
                 int d = x->degree;
                 while (A[d] != nullptr) {
                     FibHeapNode<T> *y = A[d];
-                    if (y == x) {
-                        breakFlag = true;  // when y == x, all root nodes have different degree
-                        break;               // so break out of the whole loop
-                    }
-                    if (x->key > y->key) // swap x and y, so x always points to the
-                        // node with smaller key
+                    if (x->key > y->key) // swap x and y, so x always points to the node with smaller key
                     {
                         FibHeapNode<T> *temp = x;
                         x = y;
@@ -183,20 +189,18 @@ namespace Venus::Utility::DataStructures {
                     }
                     _make_child(y, x); // make y the child of x
                     A[d++] = nullptr; // now the new node has (d + 1) child, so A[d] = nullptr,d = d + 1
+
+                    if (d >= (int) A.size())
+                        A.resize(d + 1, nullptr);
                 }
-                if (breakFlag)
-                    break;
-                A[x->degree] = x;
-                x = x->right; // to next node in the root list
+                A[d] = x;
+            }
+
+            m_minNode = nullptr;  // update the m_minNode
+            for (FibHeapNode<T> *root : A) {
+                if (root != nullptr && (m_minNode == nullptr || root->key < m_minNode->key))
+                    m_minNode = root;
             }
-            m_minNode = x;  // update the m_minNode
-            FibHeapNode<T> *iter = x;
-            do {
-                if (iter->key < m_minNode->key)
-                    m_minNode = iter;
-                iter = iter->right;
-            } while (iter != x);
-            delete[]A;
         }
 
         void _unparent_all(FibHeapNode<T> *x) {
@@ -218,10 +222,9 @@ namespace Venus::Utility::DataStructures {
                 _cascading_cut(y);
             }
 
+            // Roots are consolidated by the next pop, decreasing a key stays amortised O(1)
             if (x->key < m_minNode->key)
                 m_minNode = x;
-
-            _consolidate();
         }
 
         void _cut(FibHeapNode<T> *x, FibHeapNode<T> *y) {
@@ -233,6 +236,7 @@ namespace Venus::Utility::DataStructures {
                 y->child = x->right; // update y's child
             }
             y->degree--;
+            x->left = x->right = x; // x still points at its old siblings, unlink it before joining the roots
             _merge(m_minNode, x);
             x->parent = nullptr;
             x->mark = false;
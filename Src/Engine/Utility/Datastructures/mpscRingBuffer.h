@@ -0,0 +1,143 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_MPSCRINGBUFFER_H
+#define VENUS_MPSCRINGBUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <optional>
+#include <cstdint>
+#include <cassert>
+
+namespace Venus::Utility::DataStructures {
+    /** Size of a cache line, used to keep the producer and consumer cursors from false sharing */
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * A bounded, lock-free, multi-producer / single-consumer ring buffer.
+     *
+     * @note Any thread may push. Only a single thread may pop at any one time.
+     * @note Each cell carries a sequence number, producers claim a cell by advancing the tail and publish it by
+     * bumping the cell's sequence, so the consumer never observes a partially written item.
+     */
+    template<typename T>
+    class MPSCRingBuffer {
+    public:
+        /**
+         * Constructor
+         * @param capacity The maximum number of items the buffer can hold, must be a power of two
+         */
+        explicit MPSCRingBuffer(uint32_t capacity)
+                : _cells(std::make_unique<Cell[]>(capacity)),
+                  _capacity(capacity),
+                  _mask(capacity - 1) {
+            assert(capacity >= 2 && (capacity & (capacity - 1)) == 0 && "Capacity must be a power of two");
+
+            for (size_t i = 0; i < capacity; ++i)
+                this->_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        /** Destroys any items that were never popped */
+        ~MPSCRingBuffer() {
+            while (this->tryPop());
+        }
+
+        MPSCRingBuffer(const MPSCRingBuffer &) = delete;
+
+        MPSCRingBuffer &operator=(const MPSCRingBuffer &) = delete;
+
+        /**
+         * Attempts to push an item into the buffer
+         * @param item The item, only moved from if the push succeeds
+         * @return False if the buffer is full
+         */
+        bool tryPush(T &&item) {
+            Cell *cell;
+            size_t position = this->_tail.load(std::memory_order_relaxed);
+
+            while (true) {
+                cell = &this->_cells[position & this->_mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                if (difference == 0) {
+                    if (this->_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = this->_tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            new(cell->storage) T(std::move(item));
+            cell->sequence.store(position + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * Attempts to pop the oldest published item
+         * @note Must only be called by the consumer thread
+         * @return The item, or an empty optional if nothing has been published
+         */
+        std::optional<T> tryPop() {
+            size_t head = this->_head.load(std::memory_order_relaxed);
+            Cell &cell = this->_cells[head & this->_mask];
+
+            if (cell.sequence.load(std::memory_order_acquire) != head + 1)
+                return std::nullopt;
+
+            T *value = std::launder(reinterpret_cast<T *>(cell.storage));
+            std::optional<T> item(std::move(*value));
+            value->~T();
+
+            cell.sequence.store(head + this->_capacity, std::memory_order_release);
+            this->_head.store(head + 1, std::memory_order_relaxed);
+
+            return item;
+        }
+
+        /**
+         * Returns true if the next item to pop has not been published
+         * @note Exact when called by the consumer, a snapshot when called from any other thread
+         */
+        bool isEmpty() const {
+            size_t head = this->_head.load(std::memory_order_relaxed);
+
+            return this->_cells[head & this->_mask].sequence.load(std::memory_order_acquire) != head + 1;
+        }
+
+        /** Returns the approximate number of items in the buffer */
+        uint32_t size() const {
+            size_t tail = this->_tail.load(std::memory_order_relaxed);
+            size_t head = this->_head.load(std::memory_order_relaxed);
+
+            return tail > head ? static_cast<uint32_t>(tail - head) : 0;
+        }
+
+        /** Returns the maximum number of items the buffer can hold */
+        uint32_t capacity() const {
+            return this->_capacity;
+        }
+
+    private:
+        /** A single slot in the ring */
+        struct Cell {
+            std::atomic<size_t> sequence{0};
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        const std::unique_ptr<Cell[]> _cells;
+        const size_t _capacity;
+        const size_t _mask;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head{0};
+    };
+}
+
+#endif //VENUS_MPSCRINGBUFFER_H
@@ -0,0 +1,97 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_PRIORITYBUCKETQUEUE_H
+#define VENUS_PRIORITYBUCKETQUEUE_H
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace Venus::Utility::DataStructures {
+    /**
+     * A priority queue over a small, fixed number of priority levels, holding a FIFO bucket per level.
+     *
+     * @note Push and pop are O(1). A bit mask of the non empty buckets finds the highest level without scanning, and
+     * items of equal priority are popped in the order they were pushed.
+     * @note Not thread safe
+     */
+    template<typename T, uint32_t Levels>
+    class PriorityBucketQueue {
+        static_assert(Levels > 0 && Levels <= 32, "The non empty bucket mask holds at most 32 levels");
+
+    public:
+        /**
+         * Pushes an item to the back of its priority level
+         * @param level The item's priority level, higher levels are popped first
+         * @param item The item
+         */
+        void push(uint32_t level, T item) {
+            assert(level < Levels && "Priority level out of range");
+
+            this->_buckets[level].push_back(std::move(item));
+            this->_nonEmptyBuckets |= 1u << level;
+            ++this->_size;
+        }
+
+        /**
+         * Pops the oldest item of the highest non empty priority level
+         * @note The queue must not be empty
+         */
+        T pop() {
+            assert(!this->isEmpty() && "Cannot pop from an empty queue");
+
+            uint32_t level = std::bit_width(this->_nonEmptyBuckets) - 1;
+            auto &bucket = this->_buckets[level];
+
+            T item = std::move(bucket.front());
+            bucket.pop_front();
+
+            if (bucket.empty())
+                this->_nonEmptyBuckets &= ~(1u << level);
+
+            --this->_size;
+            return item;
+        }
+
+        /**
+         * Returns the item pop() would return
+         * @note The queue must not be empty
+         */
+        T &front() {
+            assert(!this->isEmpty() && "Cannot peek into an empty queue");
+
+            return this->_buckets[std::bit_width(this->_nonEmptyBuckets) - 1].front();
+        }
+
+        /** Destroys every queued item */
+        void clear() {
+            for (auto &bucket : this->_buckets)
+                bucket.clear();
+
+            this->_nonEmptyBuckets = 0;
+            this->_size = 0;
+        }
+
+        /** Returns the number of queued items */
+        [[nodiscard]] size_t size() const {
+            return this->_size;
+        }
+
+        /** Returns true if nothing is queued */
+        [[nodiscard]] bool isEmpty() const {
+            return this->_nonEmptyBuckets == 0;
+        }
+
+    private:
+        std::array<std::deque<T>, Levels> _buckets;
+        uint32_t _nonEmptyBuckets{0};
+        size_t _size{0};
+    };
+}
+
+#endif //VENUS_PRIORITYBUCKETQUEUE_H
@@ -64,9 +64,11 @@ namespace Venus::Utility::Events {
         void invokeWithCoreThread(QueuedEvent<eventCallback> queuedEvent, eventArgs... arguments) {
             auto coreThread = Core::CoreThread::instance();
 
-            coreThread->queueCommand([queuedEvent, arguments...]() {
+            // The flags' operators are declared in Venus::Core and are not found from here, so the flags are combined
+            // through CoreThreadQueueFlags
+            coreThread->queueCommand(Core::DiscardResult, [queuedEvent, arguments...]() {
                 queuedEvent.callback(arguments...);
-            }, CTQF_InternalQueue);
+            }, Core::CoreThreadQueueFlags(CTQF_InternalQueue) | CTQF_Realtime);
         }
 
         /**
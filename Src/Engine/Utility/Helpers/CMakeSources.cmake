@@ -1,6 +1,7 @@
 
 set(ENGINE_HELPERS_INC
         Helpers/flags.h
+        Helpers/inlineFunction.h
         )
 
 set(ENGINE_HELPERS_SRC
@@ -0,0 +1,173 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_INLINEFUNCTION_H
+#define VENUS_INLINEFUNCTION_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Venus {
+    /** Default number of bytes an InlineFunction can store without allocating */
+    static constexpr size_t INLINE_FUNCTION_DEFAULT_SIZE = 48;
+
+    template<typename Signature, size_t InlineSize = INLINE_FUNCTION_DEFAULT_SIZE>
+    class InlineFunction;
+
+    /**
+     * A move-only, type-erased callable. Callables whose captures fit within InlineSize bytes are stored inside the
+     * object itself, larger ones fall back to a single heap allocation.
+     *
+     * @note Unlike std::function the target is never copied, so move-only captures are supported.
+     */
+    template<typename Result, typename ...Args, size_t InlineSize>
+    class InlineFunction<Result(Args...), InlineSize> {
+    public:
+        InlineFunction() = default;
+
+        InlineFunction(std::nullptr_t) {}
+
+        /** Constructs the function from any callable matching the signature */
+        template<typename Callable, typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<Callable>, InlineFunction> &&
+                std::is_invocable_r_v<Result, std::decay_t<Callable> &, Args...>>>
+        InlineFunction(Callable &&callable) {
+            using Target = std::decay_t<Callable>;
+
+            if constexpr (InlineFunction::fitsInline<Target>()) {
+                new(this->_storage) Target(std::forward<Callable>(callable));
+                this->_operations = &InlineOperations<Target>::Table;
+            } else {
+                new(this->_storage) Target *(new Target(std::forward<Callable>(callable)));
+                this->_operations = &HeapOperations<Target>::Table;
+            }
+        }
+
+        InlineFunction(InlineFunction &&other) noexcept {
+            this->_moveFrom(other);
+        }
+
+        InlineFunction &operator=(InlineFunction &&other) noexcept {
+            if (this != &other) {
+                this->_reset();
+                this->_moveFrom(other);
+            }
+
+            return *this;
+        }
+
+        InlineFunction(const InlineFunction &) = delete;
+
+        InlineFunction &operator=(const InlineFunction &) = delete;
+
+        ~InlineFunction() {
+            this->_reset();
+        }
+
+        /** Invokes the stored callable */
+        Result operator()(Args... args) {
+            return this->_operations->invoke(this->_storage, std::forward<Args>(args)...);
+        }
+
+        /** Returns true if a callable is stored */
+        explicit operator bool() const {
+            return this->_operations != nullptr;
+        }
+
+        /** Returns true if the callable is stored inline, meaning no heap allocation was needed */
+        [[nodiscard]] bool isStoredInline() const {
+            return this->_operations != nullptr && this->_operations->storedInline;
+        }
+
+        /** Returns true if a callable of the given type would be stored without allocating */
+        template<typename Target>
+        static constexpr bool fitsInline() {
+            return sizeof(Target) <= InlineSize && alignof(Target) <= alignof(void *) &&
+                   std::is_nothrow_move_constructible_v<Target>;
+        }
+
+    private:
+        /** Manual virtual table for the stored callable */
+        struct Operations {
+            Result (*invoke)(void *storage, Args &&...args);
+
+            void (*move)(void *destination, void *source);
+
+            void (*destroy)(void *storage);
+
+            bool storedInline;
+        };
+
+        /** Operations for callables stored within _storage */
+        template<typename Target>
+        struct InlineOperations {
+            static Target *get(void *storage) {
+                return std::launder(reinterpret_cast<Target *>(storage));
+            }
+
+            static Result invoke(void *storage, Args &&...args) {
+                return (*get(storage))(std::forward<Args>(args)...);
+            }
+
+            static void move(void *destination, void *source) {
+                new(destination) Target(std::move(*get(source)));
+                get(source)->~Target();
+            }
+
+            static void destroy(void *storage) {
+                get(storage)->~Target();
+            }
+
+            static constexpr Operations Table{&invoke, &move, &destroy, true};
+        };
+
+        /** Operations for callables too large to be stored inline, _storage holds a pointer to the target */
+        template<typename Target>
+        struct HeapOperations {
+            static Target *&get(void *storage) {
+                return *std::launder(reinterpret_cast<Target **>(storage));
+            }
+
+            static Result invoke(void *storage, Args &&...args) {
+                return (*get(storage))(std::forward<Args>(args)...);
+            }
+
+            static void move(void *destination, void *source) {
+                new(destination) Target *(get(source));
+            }
+
+            static void destroy(void *storage) {
+                delete get(storage);
+            }
+
+            static constexpr Operations Table{&invoke, &move, &destroy, false};
+        };
+
+        /** Takes ownership of the other function's callable, leaving it empty */
+        void _moveFrom(InlineFunction &other) {
+            if (other._operations == nullptr)
+                return;
+
+            other._operations->move(this->_storage, other._storage);
+            this->_operations = other._operations;
+            other._operations = nullptr;
+        }
+
+        /** Destroys the stored callable */
+        void _reset() {
+            if (this->_operations == nullptr)
+                return;
+
+            this->_operations->destroy(this->_storage);
+            this->_operations = nullptr;
+        }
+
+        alignas(void *) unsigned char _storage[InlineSize];
+        const Operations *_operations{nullptr};
+    };
+}
+
+#endif //VENUS_INLINEFUNCTION_H
@@ -5,17 +5,37 @@ set(ENGINE_THREADING_INC
         Threading/threadPool.h
         Threading/asyncResult.h
         Threading/asyncResultImpl.h
+        Threading/typedAsyncResult.h
+        Threading/executor.h
+        Threading/coroutineTask.h
+        Threading/parallel.h
+        Threading/fiber.h
+        Threading/futex.h
+        Threading/cancellation.h
+        Threading/trace.h
+        Threading/cpuTopology.h
+        Threading/ioExecutor.h
         Threading/asyncWaitHandle.h
         Threading/asyncWaitHandleImpl.h
         Threading/TaskScheduler/taskScheduler.h
         Threading/venusThread.h
         Threading/TaskScheduler/task.h
+        Threading/TaskScheduler/taskGraph.h
         )
 
 set(ENGINE_THREADING_SRC
         Threading/TaskScheduler/taskScheduler.cpp
+        Threading/TaskScheduler/taskGraph.cpp
         Threading/pooledThread.cpp
         Threading/threadPool.cpp
         Threading/asyncResult.cpp
+        Threading/typedAsyncResult.cpp
+        Threading/executor.cpp
+        Threading/parallel.cpp
+        Threading/fiber.cpp
+        Threading/cancellation.cpp
+        Threading/trace.cpp
+        Threading/cpuTopology.cpp
+        Threading/ioExecutor.cpp
         Threading/asyncWaitHandle.cpp
         )
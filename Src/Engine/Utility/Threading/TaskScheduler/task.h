@@ -7,9 +7,11 @@
 
 #include <string>
 #include <Threading/asyncResult.h>
+#include <Threading/cancellation.h>
 #include <memory>
 #include <atomic>
 #include <utility>
+#include <vector>
 
 namespace Venus::Utility::Threading {
     /**
@@ -25,6 +27,14 @@ namespace Venus::Utility::Threading {
         VeryHigh = 102
     };
 
+    /** Number of distinct task priorities */
+    static constexpr uint32_t TASK_PRIORITY_LEVELS = 6;
+
+    /** Returns the zero based level of the priority, VeryLow being the lowest level */
+    constexpr uint32_t getTaskPriorityLevel(TaskPriority priority) {
+        return static_cast<uint32_t>(priority) - static_cast<uint32_t>(TaskPriority::VeryLow);
+    }
+
     /**
      * The current state the task is in
      */
@@ -49,8 +59,8 @@ namespace Venus::Utility::Threading {
          */
         Completed,
         /**
-         * Task been cancelled and will not be Scheduled
-         * @note If task has been Scheduled it cannot be cancelled
+         * Task has been cancelled and its work will not be run
+         * @note A task is cancelled up until it starts, once InProgress it can only stop by polling its token
          */
         Cancelled
     };
@@ -77,12 +87,25 @@ namespace Venus::Utility::Threading {
         /** The task's dependency */
         std::shared_ptr<Task> Dependency{nullptr};
 
+        /** Further tasks that must complete before the task is run */
+        std::vector<std::shared_ptr<Task>> Dependencies;
+
+        /** Groups whose every task must complete before the task is run */
+        std::vector<std::shared_ptr<TaskGroup>> GroupDependencies;
+
+        /** Cancels the task if requested before it starts, the work polls it to stop early once running */
+        CancellationToken Cancellation{};
+
         /** Task identifier */
         std::uint32_t TaskId;
     };
 
     /**
      * Represents a single executable work item in the task scheduler
+     *
+     * @note Tasks form a graph, each task counts its unfinished predecessors and lists the successors waiting on it.
+     * A task is handed to the thread pool the moment its count drops to zero, by the thread adding it or by the
+     * worker completing its last predecessor.
      */
     class Task {
     public:
@@ -92,8 +115,13 @@ namespace Venus::Utility::Threading {
                   _taskId(model.TaskId),
                   _taskName(model.TaskName),
                   _priority(model.Priority),
-                  _taskDependency(model.Dependency) {
+                  _cancellation(model.Cancellation),
+                  _dependencies(model.Dependencies),
+                  _groupDependencies(model.GroupDependencies) {
             this->_taskStatus = TaskStatus::Waiting;
+
+            if (model.Dependency != nullptr)
+                this->_dependencies.push_back(model.Dependency);
         }
 
         /** Returns true if the task has completed */
@@ -103,13 +131,22 @@ namespace Venus::Utility::Threading {
             return this->_taskStatus == TaskStatus::Completed;
         }
 
-        /** Returns true if the task has been cancelled */
+        /**
+         * Returns true if the task has been cancelled
+         * @note A task whose token is cancelled reports so once a worker has skipped it
+         */
         [[nodiscard("Unnecessary call")]]
         bool isCancelled() {
             Lock lock(_taskMutex);
             return this->_taskStatus == TaskStatus::Cancelled;
         }
 
+        /** Returns the token the task was created with */
+        [[nodiscard("Unnecessary call")]]
+        const CancellationToken &getCancellationToken() const {
+            return this->_cancellation;
+        }
+
         /** Returns true if the task has started */
         [[nodiscard("Unnecessary call")]]
         bool hasStarted() {
@@ -130,30 +167,47 @@ namespace Venus::Utility::Threading {
             return this->_taskId;
         }
 
+        /** Returns the task's priority */
+        [[nodiscard("Unnecessary call")]]
+        TaskPriority getPriority() {
+            Lock lock(this->_taskMutex);
+            return this->_priority;
+        }
+
         /**
-         * Blocks the calling thread until the task has been marked as complete
+         * Blocks the calling thread until the task has been marked as complete, or skipped having been cancelled
+         * @note Called from a task run by a fiber backed TaskScheduler, the task's fiber is suspended instead and the
+         * worker moves on to other work
          */
         void wait() {
-            {
-                Lock lock(_taskMutex);
+            std::shared_ptr<AsyncWaitHandle> waitHandle = this->getWaitHandle();
 
-                if (this->_asyncWaitHandle == nullptr) {
-                    spdlog::warn("Task {} waiting for start, task not scheduled",
-                                 this->_taskId);
+            if (waitHandle == nullptr) {
+                // Usual for a task added to the scheduler moments ago, it has not been dispatched yet
+                spdlog::debug("Task {} waiting for start, task not scheduled", this->getTaskId());
 
-                    this->_startedSignal.wait();
-                }
+                // Not under the task mutex, the worker starting the task needs it to update the task's status
+                this->_startedSignal.wait();
+                waitHandle = this->getWaitHandle();
             }
 
-            this->_asyncWaitHandle->wait();
+            waitHandle->wait();
         }
 
         /**
          * Marks the task as cancelled, will not stop task if it is already running
+         * @return False if the task had already started
+         * @note A queued task is not searched for, the worker reaching it skips it and signals its wait handle
+         * @note Tasks depending on a cancelled task are cancelled in turn and never run
          */
-        void cancel() {
+        bool cancel() {
             Lock lock(this->_taskMutex);
+
+            if (this->_taskStatus != TaskStatus::Waiting && this->_taskStatus != TaskStatus::Scheduled)
+                return this->_taskStatus == TaskStatus::Cancelled;
+
             this->_taskStatus = TaskStatus::Cancelled;
+            return true;
         }
 
     private:
@@ -181,12 +235,99 @@ namespace Venus::Utility::Threading {
             this->_taskStatus = taskStatus;
         }
 
+        /** Moves the task to Scheduled as it is queued on a worker, a cancelled task stays cancelled */
+        void _markScheduled() {
+            Lock lock(this->_taskMutex);
+
+            if (this->_taskStatus != TaskStatus::Cancelled)
+                this->_taskStatus = TaskStatus::Scheduled;
+        }
+
         /** Sets the task's priority*/
         void _setPriority(TaskPriority priority) {
             Lock lock(this->_taskMutex);
             this->_priority = priority;
         }
 
+        /**
+         * Lists a task to be released once this one completes
+         * @return False if this task has already finished, the successor is not listed and is cancelled if this
+         * task was
+         */
+        bool _addSuccessor(const std::shared_ptr<Task> &successor) {
+            {
+                Lock lock(this->_taskMutex);
+
+                if (!this->_finished) {
+                    this->_successors.push_back(successor);
+                    return true;
+                }
+
+                if (this->_taskStatus != TaskStatus::Cancelled)
+                    return false;
+            }
+
+            successor->cancel();
+            return false;
+        }
+
+        /**
+         * Moves the task to InProgress unless it has been cancelled, directly or through its token
+         * @return False if the task is cancelled, its work is skipped
+         */
+        bool _tryStart() {
+            Lock lock(this->_taskMutex);
+
+            if (this->_taskStatus != TaskStatus::Cancelled && this->_cancellation.isCancellationRequested())
+                this->_taskStatus = TaskStatus::Cancelled;
+
+            if (this->_taskStatus == TaskStatus::Cancelled)
+                return false;
+
+            this->_taskStatus = TaskStatus::InProgress;
+            return true;
+        }
+
+        /** Returns true if the task will be skipped when a worker reaches it */
+        bool _isCancellationPending() {
+            return this->_cancellation.isCancellationRequested() || this->isCancelled();
+        }
+
+        /**
+         * Marks the task as complete, or leaves it cancelled if its work was skipped
+         * @return The successors waiting on the task, for the caller to release, cancelled if this task was
+         */
+        std::vector<std::shared_ptr<Task>> _complete() {
+            std::vector<std::shared_ptr<Task>> successors;
+            bool cancelled;
+
+            {
+                Lock lock(this->_taskMutex);
+
+                cancelled = this->_taskStatus == TaskStatus::Cancelled;
+                if (!cancelled)
+                    this->_taskStatus = TaskStatus::Completed;
+
+                this->_finished = true;
+                successors = std::exchange(this->_successors, {});
+            }
+
+            if (cancelled) {
+                for (const auto &successor : successors)
+                    successor->cancel();
+            }
+
+            return successors;
+        }
+
+        /**
+         * Counts one of the task's predecessors as finished
+         * @return True if it was the last, the task is ready to run
+         */
+        bool _releasePredecessor() {
+            return this->_unfinishedPredecessors.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
         Mutex _taskMutex;
         AsyncWaitHandleImpl _startedSignal;
 
@@ -202,8 +343,27 @@ namespace Venus::Utility::Threading {
         bool _isInGroup{false};
         uint32_t _taskGroupId{0};
 
+        /** Set by a fiber backed TaskScheduler, the task is run on a fiber so its waits suspend rather than block */
+        bool _runOnFiber{false};
+
+        /** Set once the task has completed or been skipped, guarded by the task mutex */
+        bool _finished{false};
+
         const std::function<void()> _work;
-        const std::shared_ptr<Task> _taskDependency{nullptr};
+        const CancellationToken _cancellation;
+
+        /** The task's predecessors, only held until the task is added to the scheduler */
+        std::vector<std::shared_ptr<Task>> _dependencies;
+        std::vector<std::shared_ptr<TaskGroup>> _groupDependencies;
+
+        /** Predecessors yet to complete, plus one held by the scheduler while it lists the task with them */
+        std::atomic_uint32_t _unfinishedPredecessors{0};
+
+        /** Tasks waiting on this one, guarded by the task mutex and handed out once it completes */
+        std::vector<std::shared_ptr<Task>> _successors;
+
+        /** Keeps the task alive while it sits in a worker's work stealing deque, which only holds raw pointers */
+        std::shared_ptr<Task> _queuedReference{nullptr};
     };
 
     /** Description model used to create task groups */
@@ -220,6 +380,12 @@ namespace Venus::Utility::Threading {
 
         /** The groups dependency */
         std::shared_ptr<Task> Dependency;
+
+        /** Further tasks that must complete before the group's tasks are run */
+        std::vector<std::shared_ptr<Task>> Dependencies;
+
+        /** Cancels every task in the group, along with the tokens of the tasks themselves */
+        CancellationToken Cancellation{};
     };
 
     /**
@@ -233,7 +399,9 @@ namespace Venus::Utility::Threading {
         explicit TaskGroup(const TaskGroupDescription &description)
                 : _groupPriority(description.GroupPriority),
                   _groupName(description.Name),
-                  _dependency(description.Dependency) {
+                  _dependency(description.Dependency),
+                  _dependencies(description.Dependencies),
+                  _cancellation(description.Cancellation) {
             this->createNewTaskFromGroupDescription(description);
         }
 
@@ -257,6 +425,16 @@ namespace Venus::Utility::Threading {
             }
         }
 
+        /**
+         * Cancels every task in the group that has not started
+         * @note Tasks depending on the group are cancelled in turn, cancel the group's token to also stop the
+         * tasks already running
+         */
+        void cancel() {
+            for (const auto &task : this->_tasks)
+                task->cancel();
+        }
+
         /**
          * Adds a new task to the group
          * @param taskDescription Task description instance
@@ -264,6 +442,7 @@ namespace Venus::Utility::Threading {
         void addNewTask(TaskDescription taskDescription) {
             overWriteTaskPriority(taskDescription);
             overWriteTaskDependency(taskDescription);
+            linkTaskCancellation(taskDescription);
 
             auto task = std::make_shared<Task>(taskDescription);
             this->_tasks.push_back(task);
@@ -272,13 +451,16 @@ namespace Venus::Utility::Threading {
     private:
         friend class TaskScheduler;
 
-        std::vector<std::shared_ptr<Task>> _tasks{nullptr};
+        std::vector<std::shared_ptr<Task>> _tasks{};
         TaskPriority _groupPriority{TaskPriority::Normal};
 
         uint32_t _id{0};
         std::string _groupName;
 
         std::shared_ptr<Task> _dependency{nullptr};
+        std::vector<std::shared_ptr<Task>> _dependencies;
+
+        CancellationToken _cancellation{};
 
         /** Create a new task the existing group description */
         void createNewTaskFromGroupDescription(const TaskGroupDescription &description) {
@@ -294,6 +476,22 @@ namespace Venus::Utility::Threading {
 
         void overWriteTaskDependency(TaskDescription &taskDescription) {
             taskDescription.Dependency = this->_dependency;
+            taskDescription.Dependencies.insert(taskDescription.Dependencies.end(), this->_dependencies.begin(),
+                                                this->_dependencies.end());
+        }
+
+        /** Has the task description's token cancelled along with the group's */
+        void linkTaskCancellation(TaskDescription &taskDescription) {
+            if (!this->_cancellation.canBeCancelled())
+                return;
+
+            if (!taskDescription.Cancellation.canBeCancelled()) {
+                taskDescription.Cancellation = this->_cancellation;
+                return;
+            }
+
+            CancellationSource linked({taskDescription.Cancellation, this->_cancellation});
+            taskDescription.Cancellation = linked.getToken();
         }
     };
 }
@@ -0,0 +1,259 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "taskGraph.h"
+#include <Threading/threadPool.h>
+#include <Error/venusExceptions.h>
+#include <algorithm>
+#include <cassert>
+
+namespace Venus::Utility::Threading {
+    uint32_t TaskGraph::addNode(Work &&work) {
+        if (this->_compiled)
+            VENUS_EXCEPT(InvalidOperationException, "Nodes cannot be added to a compiled task graph");
+
+        this->_declaredWork.push_back(std::move(work));
+        return static_cast<uint32_t>(this->_declaredWork.size() - 1);
+    }
+
+    void TaskGraph::addDependency(uint32_t node, uint32_t dependency) {
+        if (this->_compiled)
+            VENUS_EXCEPT(InvalidOperationException, "Dependencies cannot be added to a compiled task graph");
+
+        assert(node < this->_declaredWork.size() && dependency < this->_declaredWork.size() && "Unknown node");
+        this->_declaredDependencies.emplace_back(node, dependency);
+    }
+
+    void TaskGraph::compile() {
+        if (this->_compiled)
+            VENUS_EXCEPT(InvalidOperationException, "The task graph has already been compiled");
+
+        auto count = static_cast<uint32_t>(this->_declaredWork.size());
+
+        // Successors of the declared nodes, grouped by node
+        std::vector<uint32_t> predecessorCounts(count, 0);
+        std::vector<uint32_t> firstSuccessors(count + 1, 0);
+
+        for (const auto &[node, dependency] : this->_declaredDependencies) {
+            ++predecessorCounts[node];
+            ++firstSuccessors[dependency + 1];
+        }
+
+        for (uint32_t node = 0; node < count; ++node)
+            firstSuccessors[node + 1] += firstSuccessors[node];
+
+        std::vector<uint32_t> declaredSuccessors(this->_declaredDependencies.size());
+        std::vector<uint32_t> insertAt(firstSuccessors.begin(), firstSuccessors.end() - 1);
+
+        for (const auto &[node, dependency] : this->_declaredDependencies)
+            declaredSuccessors[insertAt[dependency]++] = node;
+
+        // Kahn's algorithm a level at a time, a node lands in the level after its last dependency
+        std::vector<uint32_t> order;
+        order.reserve(count);
+
+        std::vector<uint32_t> remaining = predecessorCounts;
+        for (uint32_t node = 0; node < count; ++node) {
+            if (remaining[node] == 0)
+                order.push_back(node);
+        }
+
+        this->_rootCount = static_cast<uint32_t>(order.size());
+
+        for (size_t levelBegin = 0; levelBegin < order.size();) {
+            size_t levelEnd = order.size();
+            this->_maximumWidth = std::max(this->_maximumWidth, static_cast<uint32_t>(levelEnd - levelBegin));
+
+            for (size_t i = levelBegin; i < levelEnd; ++i) {
+                for (uint32_t s = firstSuccessors[order[i]]; s < firstSuccessors[order[i] + 1]; ++s) {
+                    if (--remaining[declaredSuccessors[s]] == 0)
+                        order.push_back(declaredSuccessors[s]);
+                }
+            }
+
+            levelBegin = levelEnd;
+        }
+
+        if (order.size() != count)
+            VENUS_EXCEPT(InvalidOperationException, "The task graph's dependencies form a cycle");
+
+        std::vector<uint32_t> sortedIndex(count);
+        for (uint32_t i = 0; i < count; ++i)
+            sortedIndex[order[i]] = i;
+
+        this->_nodes.resize(count);
+        this->_successors.reserve(declaredSuccessors.size());
+
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t declared = order[i];
+            Node &node = this->_nodes[i];
+
+            node.work = std::move(this->_declaredWork[declared]);
+            node.predecessorCount = predecessorCounts[declared];
+            node.firstSuccessor = static_cast<uint32_t>(this->_successors.size());
+            node.successorCount = firstSuccessors[declared + 1] - firstSuccessors[declared];
+
+            for (uint32_t s = firstSuccessors[declared]; s < firstSuccessors[declared + 1]; ++s)
+                this->_successors.push_back(sortedIndex[declaredSuccessors[s]]);
+        }
+
+        this->_declaredWork = std::vector<Work>();
+        this->_declaredDependencies = std::vector<std::pair<uint32_t, uint32_t>>();
+
+        this->_pendingPredecessors = std::make_unique<std::atomic_uint32_t[]>(count);
+        this->_readyNodes = std::make_unique<std::atomic_uint32_t[]>(count);
+        this->_compiled = true;
+    }
+
+    void TaskGraph::execute() {
+        if (!this->_compiled)
+            VENUS_EXCEPT(InvalidOperationException, "A task graph must be compiled before it is executed");
+
+        auto count = static_cast<uint32_t>(this->_nodes.size());
+        if (count == 0)
+            return;
+
+        for (uint32_t node = 0; node < count; ++node) {
+            this->_pendingPredecessors[node].store(this->_nodes[node].predecessorCount, std::memory_order_relaxed);
+            this->_readyNodes[node].store(node < this->_rootCount ? node + 1 : 0, std::memory_order_relaxed);
+        }
+
+        this->_readyHead.store(0, std::memory_order_relaxed);
+        this->_readyTail.store(this->_rootCount, std::memory_order_relaxed);
+        this->_completedNodes.store(0, std::memory_order_relaxed);
+        this->_failed.store(false, std::memory_order_relaxed);
+        this->_exception = nullptr;
+
+        uint32_t helpers = std::min(ThreadPool::instance()->getWorkerQuota(), this->_maximumWidth - 1);
+        this->_activeHelpers.store(helpers, std::memory_order_release);
+
+        for (uint32_t i = 0; i < helpers; ++i)
+            ThreadPool::instance()->queueWork([this]() { this->_runHelper(); });
+
+        this->_runUntilComplete();
+
+        // Helpers still queued hold on to the graph, they return straight away once they get to run
+        while (true) {
+            uint32_t active = this->_activeHelpers.load(std::memory_order_acquire);
+            if (active == 0)
+                break;
+
+            if (!ThreadPool::runPendingWork())
+                this->_activeHelpers.wait(active, std::memory_order_acquire);
+        }
+
+        if (this->_exception != nullptr)
+            std::rethrow_exception(this->_exception);
+    }
+
+    void TaskGraph::_runHelper() {
+        this->_runUntilComplete();
+
+        if (this->_activeHelpers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            this->_activeHelpers.notify_all();
+    }
+
+    void TaskGraph::_runUntilComplete() {
+        auto count = static_cast<uint32_t>(this->_nodes.size());
+
+        while (!this->_failed.load(std::memory_order_acquire)) {
+            uint32_t node;
+            if (this->_tryTakeReadyNode(node)) {
+                this->_runNode(node);
+                continue;
+            }
+
+            // Read before looking again, a node published or the graph completing or failing after this changes it
+            uint32_t wakeCount = this->_wakeCount.load(std::memory_order_acquire);
+
+            if (this->_completedNodes.load(std::memory_order_acquire) == count ||
+                this->_failed.load(std::memory_order_acquire))
+                return;
+
+            uint32_t head = this->_readyHead.load(std::memory_order_acquire);
+            if (head < count && this->_readyNodes[head].load(std::memory_order_acquire) != 0)
+                continue;
+
+            // A helper sleeping here would hold on to its worker, enough graphs at once would tie up the whole pool
+            if (ThreadPool::runPendingWork())
+                continue;
+
+            this->_wakeCount.wait(wakeCount, std::memory_order_acquire);
+        }
+    }
+
+    void TaskGraph::_runNode(uint32_t index) {
+        Node &node = this->_nodes[index];
+
+        // The successors of a node that threw are never readied, the runners stop on the failure instead
+        try {
+            node.work();
+        } catch (...) {
+            this->_fail(std::current_exception());
+            return;
+        }
+
+        for (uint32_t s = node.firstSuccessor; s < node.firstSuccessor + node.successorCount; ++s) {
+            uint32_t successor = this->_successors[s];
+
+            if (this->_pendingPredecessors[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                this->_pushReadyNode(successor);
+        }
+
+        auto count = static_cast<uint32_t>(this->_nodes.size());
+        if (this->_completedNodes.fetch_add(1, std::memory_order_acq_rel) + 1 == count)
+            this->_wakeRunners(true);
+    }
+
+    void TaskGraph::_pushReadyNode(uint32_t node) {
+        uint32_t slot = this->_readyTail.fetch_add(1, std::memory_order_relaxed);
+        this->_readyNodes[slot].store(node + 1, std::memory_order_release);
+
+        this->_wakeRunners(false);
+    }
+
+    bool TaskGraph::_tryTakeReadyNode(uint32_t &node) {
+        auto count = static_cast<uint32_t>(this->_nodes.size());
+        uint32_t head = this->_readyHead.load(std::memory_order_acquire);
+
+        while (head < count) {
+            // A slot is reserved before it is written, so a later slot may be published before this one
+            uint32_t published = this->_readyNodes[head].load(std::memory_order_acquire);
+            if (published == 0)
+                return false;
+
+            if (this->_readyHead.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel,
+                                                       std::memory_order_acquire)) {
+                node = published - 1;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void TaskGraph::_wakeRunners(bool all) {
+        this->_wakeCount.fetch_add(1, std::memory_order_release);
+
+        if (all)
+            this->_wakeCount.notify_all();
+        else
+            this->_wakeCount.notify_one();
+    }
+
+    void TaskGraph::_fail(std::exception_ptr exception) {
+        if (!this->_failed.exchange(true, std::memory_order_acq_rel))
+            this->_exception = std::move(exception);
+
+        this->_wakeRunners(true);
+    }
+
+    bool TaskGraph::isCompiled() const {
+        return this->_compiled;
+    }
+
+    uint32_t TaskGraph::getNodeCount() const {
+        return static_cast<uint32_t>(this->_compiled ? this->_nodes.size() : this->_declaredWork.size());
+    }
+}
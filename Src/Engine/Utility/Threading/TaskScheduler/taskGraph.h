@@ -0,0 +1,143 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_TASKGRAPH_H
+#define VENUS_TASKGRAPH_H
+
+#include <Helpers/inlineFunction.h>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Venus::Utility::Threading {
+    /**
+     * A graph of work declared once and executed many times, such as the work making up a frame.
+     *
+     * Nodes and the dependencies between them are declared up front, compile() then sorts the nodes topologically
+     * into flat arrays holding each node's successors and predecessor count. Executing the graph only resets those
+     * counts: no tasks, wait handles or names are created per node, and no scheduler thread is involved.
+     *
+     * @note execute() runs nodes on the calling thread and on helpers queued on the ThreadPool, one per extra node
+     * that can run at once up to the pool's worker quota. The helpers are the only allocations made per execution.
+     * @note Not thread safe, a graph must not be declared or executed from more than one thread at a time
+     */
+    class TaskGraph {
+    public:
+        /** The work of a single node, invoked once per execution */
+        using Work = InlineFunction<void()>;
+
+        TaskGraph() = default;
+
+        TaskGraph(const TaskGraph &) = delete;
+
+        TaskGraph &operator=(const TaskGraph &) = delete;
+
+        /**
+         * Declares a node
+         * @param work The node's work
+         * @return The node's identifier
+         * @note The graph must not have been compiled
+         */
+        uint32_t addNode(Work &&work);
+
+        /**
+         * Declares that a node may only run once another has completed
+         * @param node The node
+         * @param dependency The node it depends on
+         * @note The graph must not have been compiled
+         */
+        void addDependency(uint32_t node, uint32_t dependency);
+
+        /**
+         * Sorts the declared nodes topologically and builds the arrays execute() runs from
+         * @note Aborts if the dependencies form a cycle. The graph cannot be changed once compiled.
+         */
+        void compile();
+
+        /**
+         * Runs every node once, each after all of its dependencies, returning once all have completed
+         * @note The graph must have been compiled
+         * @note If a node throws the nodes not yet started are skipped, and the first exception is rethrown once every
+         * helper has returned
+         */
+        void execute();
+
+        /** Returns true if compile() has been called */
+        [[nodiscard]] bool isCompiled() const;
+
+        /** Returns the number of nodes */
+        [[nodiscard]] uint32_t getNodeCount() const;
+
+    private:
+        /** A compiled node, successors are stored in the graph's successor array */
+        struct Node {
+            Work work;
+            uint32_t predecessorCount{0};
+            uint32_t firstSuccessor{0};
+            uint32_t successorCount{0};
+        };
+
+        /**
+         * Runs ready nodes until the graph has completed or failed. While nodes run elsewhere a pool worker helps with
+         * other pending work, only once there is none does it sleep.
+         */
+        void _runUntilComplete();
+
+        /** Helper queued on the ThreadPool by execute() */
+        void _runHelper();
+
+        /** Runs the node and readies each successor whose last dependency it was */
+        void _runNode(uint32_t node);
+
+        /** Publishes a node whose dependencies have completed */
+        void _pushReadyNode(uint32_t node);
+
+        /**
+         * Claims the oldest published node
+         * @return False if no node has been published yet
+         */
+        bool _tryTakeReadyNode(uint32_t &node);
+
+        /** Wakes threads sleeping in _runUntilComplete() */
+        void _wakeRunners(bool all);
+
+        /** Records the exception if it is the first one thrown, and wakes every runner to stop */
+        void _fail(std::exception_ptr exception);
+
+        /** Declared nodes and edges, consumed by compile() */
+        std::vector<Work> _declaredWork;
+        std::vector<std::pair<uint32_t, uint32_t>> _declaredDependencies;
+
+        bool _compiled{false};
+
+        /** Nodes in topological order, the nodes without dependencies first */
+        std::vector<Node> _nodes;
+        std::vector<uint32_t> _successors;
+        uint32_t _rootCount{0};
+
+        /** The most nodes that can run at once, the size of the widest level of the graph */
+        uint32_t _maximumWidth{0};
+
+        /** Execution state, reset by every execute() */
+        std::unique_ptr<std::atomic_uint32_t[]> _pendingPredecessors;
+
+        /** Published nodes, each slot is written once per execution and holds the node plus one once published */
+        std::unique_ptr<std::atomic_uint32_t[]> _readyNodes;
+        std::atomic_uint32_t _readyHead{0};
+        std::atomic_uint32_t _readyTail{0};
+
+        std::atomic_uint32_t _completedNodes{0};
+        std::atomic_uint32_t _wakeCount{0};
+        std::atomic_uint32_t _activeHelpers{0};
+
+        /** Set once a node has thrown, the exception is written before the runners are woken */
+        std::atomic_bool _failed{false};
+        std::exception_ptr _exception{nullptr};
+    };
+}
+
+#endif //VENUS_TASKGRAPH_H
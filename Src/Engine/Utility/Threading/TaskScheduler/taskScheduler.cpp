@@ -3,34 +3,37 @@
 //
 
 #include "taskScheduler.h"
-#include <pthread.h>
 
 namespace Venus::Utility::Threading {
+    TaskScheduler::TaskScheduler(const TaskSchedulerDescription &description)
+            : _enableFibers(description.enableFibers),
+              _fiberStackSize(description.fiberStackSize) {}
+
     void TaskScheduler::ignition() {
-        this->_taskSchedulerThread = std::make_unique<VenusThread>([this]() {
-            this->_runTaskSchedulerLoop();
-        });
+        if (this->_enableFibers && !Fiber::isSupported()) {
+            spdlog::warn("Fibers are not supported on this platform, tasks will block their workers while waiting");
+            this->_enableFibers = false;
+        }
+
+        if (this->_enableFibers)
+            Fiber::setStackSize(this->_fiberStackSize);
     }
 
     uint32_t TaskScheduler::addTask(const std::shared_ptr<Task> &task) {
-        assert(task->_taskStatus > TaskStatus::Waiting && "The task is marked as running and cannot be queued");
+        assert((task->_taskStatus == TaskStatus::Waiting || task->_taskStatus == TaskStatus::Cancelled) &&
+               "The task is marked as running and cannot be queued");
 
-        Lock lock(this->_readyMutex);
-
-        this->_taskQueue.push_back(task);
-        this->_checkTasks = true;
-
-        this->_taskReadyCond.notify_one();
+        this->_scheduleTask(task);
         return task->getTaskId();
     }
 
     uint32_t TaskScheduler::addTaskGroup(const std::shared_ptr<TaskGroup> &taskGroup) {
-        Lock lock(this->_readyMutex);
-
         for (const auto &task : taskGroup->_tasks) {
+            assert((task->_taskStatus == TaskStatus::Waiting || task->_taskStatus == TaskStatus::Cancelled) &&
+                   "The task is marked as running and cannot be queued");
             TaskScheduler::initTaskForGroup(task, taskGroup->_id);
 
-            this->addTask(task);
+            this->_scheduleTask(task);
         }
 
         return taskGroup->_id;
@@ -41,55 +44,45 @@ namespace Venus::Utility::Threading {
         task->_taskGroupId = groupId;
     }
 
-    void TaskScheduler::addWorker() {
-        ThreadPool::instance()->addWorker();
-
-        this->_checkTasks = true;
-        this->_taskReadyCond.notify_one();
-    }
-
-    void TaskScheduler::removeWorker() {
-        ThreadPool::instance()->removeWorker();
-    }
+    void TaskScheduler::_scheduleTask(const std::shared_ptr<Task> &task) const {
+        task->_runOnFiber = this->_enableFibers;
 
-    void TaskScheduler::_runTaskSchedulerLoop() {
-        while (!this->_shutdown) {
-            Lock lock(this->_readyMutex);
+        // Held while the task is listed with its dependencies, so none of them completing can release it early
+        task->_unfinishedPredecessors.store(1, std::memory_order_relaxed);
 
-            while ((!this->_checkTasks) && !this->_shutdown)
-                this->_taskReadyCond.wait(lock);
+        for (const auto &dependency : task->_dependencies)
+            TaskScheduler::_addPredecessor(task, dependency);
 
-            this->_checkTasks = false;
+        for (const auto &group : task->_groupDependencies) {
+            for (const auto &dependency : group->_tasks)
+                TaskScheduler::_addPredecessor(task, dependency);
+        }
 
-            for (auto iter = this->_taskQueue.begin(); iter != this->_taskQueue.end();) {
-                std::shared_ptr<Task> curTask = *iter;
+        // The dependencies hold on to the task until they complete, holding on to them in turn would leak both
+        task->_dependencies.clear();
+        task->_groupDependencies.clear();
 
-                if (curTask->isCancelled()) {
-                    iter = this->_taskQueue.erase(iter);
-                    continue;
-                }
+        if (task->_releasePredecessor())
+            ThreadPool::instance()->_addScheduledWork(task);
+    }
 
-                if (curTask->_taskDependency != nullptr && !curTask->_taskDependency->isComplete()) {
-                    ++iter;
-                    continue;
-                }
+    void TaskScheduler::_addPredecessor(const std::shared_ptr<Task> &task, const std::shared_ptr<Task> &dependency) {
+        task->_unfinishedPredecessors.fetch_add(1, std::memory_order_relaxed);
 
-                ThreadPool::instance()->_addScheduledWork(curTask);
-                this->_taskQueue.erase(iter);
-            }
-        }
+        if (!dependency->_addSuccessor(task))
+            task->_unfinishedPredecessors.fetch_sub(1, std::memory_order_relaxed);
     }
 
-    void TaskScheduler::shutdown() {
-        {
-            Lock lock(this->_readyMutex);
-            this->_shutdown = true;
-        }
+    void TaskScheduler::addWorker() {
+        ThreadPool::instance()->addWorker();
+    }
 
-        this->_taskReadyCond.notify_all();
-        this->_taskSchedulerThread->join();
+    void TaskScheduler::removeWorker() {
+        ThreadPool::instance()->removeWorker();
     }
 
+    void TaskScheduler::shutdown() {}
+
     void TaskScheduler::waitTillGroupComplete(const std::shared_ptr<TaskGroup> &taskGroup) {
         for (const auto& task : taskGroup->_tasks) {
             task->wait();
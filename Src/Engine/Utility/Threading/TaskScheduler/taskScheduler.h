@@ -6,12 +6,27 @@
 #define VENUS_TASKSCHEDULER_H
 
 #include "task.h"
-#include <Threading/venusThread.h>
 #include <Threading/threading.h>
 #include <Threading/threadPool.h>
+#include <Threading/fiber.h>
 #include <Module.h>
 
 namespace Venus::Utility::Threading {
+    /** Description used to create a task scheduler */
+    struct TaskSchedulerDescription {
+    public:
+        /**
+         * Boolean indicating if tasks are run on fibers
+         * @note A task waiting on another task or group then suspends its fiber instead of holding on to the worker,
+         * the fiber is resumed on the pool once the dependency completes. Falls back to the thread blocking model
+         * where fibers are not supported.
+         */
+        bool enableFibers{false};
+
+        /** The stack size of each fiber, tasks run on fibers must fit their call stack within it */
+        size_t fiberStackSize{FIBER_DEFAULT_STACK_SIZE};
+    };
+
     /**
      * Represents a task scheduler running on multiple threads.
      *
@@ -22,11 +37,20 @@ namespace Venus::Utility::Threading {
      *
      * @note The task scheduler uses the thread pool instance to queue new tasks, new threads can be added to threadpool
      * using addWorker and removeWorker
+     *
+     * @note Tasks are never polled. Adding a task lists it as a successor of each of its unfinished dependencies, a
+     * task with none is handed to the pool straight away and any other by the worker completing its last dependency.
      */
     class TaskScheduler : public Module<TaskScheduler> {
     public:
         TaskScheduler() = default;
 
+        /**
+         * Constructor
+         * @param description The scheduler's description
+         */
+        explicit TaskScheduler(const TaskSchedulerDescription &description);
+
         /** Does the modules initial initialisation */
         void ignition() override;
 
@@ -34,6 +58,8 @@ namespace Venus::Utility::Threading {
          * Adds a new task to be scheduled by this scheduler and executed on the thread pool
          * @param task The task to be added
          * @note Task status must be Inactive
+         * @note The task runs once all of its dependencies have completed, the dependencies do not need to have been
+         * added yet
          * @return The task's unique id
          */
         uint32_t addTask(const std::shared_ptr<Task> &task);
@@ -57,7 +83,10 @@ namespace Venus::Utility::Threading {
         /** Removes a worker from the thread pool */
         static void removeWorker();
 
-        /** shutdown the task scheduler */
+        /**
+         * shutdown the task scheduler
+         * @note The scheduler owns no thread, tasks already handed to the pool complete there
+         */
         void shutdown() override;
 
     private:
@@ -65,20 +94,18 @@ namespace Venus::Utility::Threading {
         /** Updates the given task's properties for group operation*/
         static void initTaskForGroup(const std::shared_ptr<Task> &task, uint32_t groupId);
 
-        /** Main task scheduler method that dispatches tasks to threadpool. */
-        void _runTaskSchedulerLoop();
+        /** Lists the task with each of its unfinished dependencies, handing it to the pool if there are none */
+        void _scheduleTask(const std::shared_ptr<Task> &task) const;
 
-        std::vector<std::shared_ptr<Task>> _taskQueue;
-
-        std::unique_ptr<VenusThread> _taskSchedulerThread{nullptr};
-
-        bool _checkTasks{true};
-        bool _shutdown{false};
+        /**
+         * Lists the task as a successor of the dependency, counting the dependency as unfinished
+         * @note Counted before it is listed, were it counted after the dependency could complete in between and
+         * release the task early
+         */
+        static void _addPredecessor(const std::shared_ptr<Task> &task, const std::shared_ptr<Task> &dependency);
 
-        Mutex _readyMutex;
-        Mutex _completeMutex;
-        Signal _taskReadyCond;
-        Signal _taskCompleteCond;
+        bool _enableFibers{false};
+        size_t _fiberStackSize{FIBER_DEFAULT_STACK_SIZE};
     };
 }
 
@@ -29,4 +29,20 @@ namespace Venus::Utility::Threading {
 
         return this->_syncData->getReturnedValue();
     }
+
+    void AsyncResult::addContinuation(Executor::Work &&continuation, Executor &executor) {
+        this->_syncData->addContinuation(std::move(continuation), executor);
+    }
+
+    std::shared_ptr<AsyncResult> AsyncResult::then(Executor::Work &&continuation, Executor &executor) {
+        auto next = std::make_shared<AsyncResult>();
+
+        this->_syncData->addContinuation(
+                [continuation = std::move(continuation), nextSyncData = next->_syncData]() mutable {
+                    continuation();
+                    nextSyncData->markAsComplete();
+                }, executor);
+
+        return next;
+    }
 }
\ No newline at end of file
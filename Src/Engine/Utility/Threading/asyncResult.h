@@ -7,7 +7,9 @@
 
 #include <genericObject.h>
 #include <memory>
+#include <vector>
 #include "threading.h"
+#include "executor.h"
 #include <spdlog/spdlog.h>
 #include "asyncWaitHandleImpl.h"
 
@@ -45,14 +47,46 @@ namespace Venus::Utility::Threading {
 
         /** Marks the current operation as complete*/
         void markAsComplete() {
-            Lock lock(this->_completedMutex);
+            std::vector<Continuation> continuations;
+
+            {
+                Lock lock(this->_completedMutex);
+
+                this->_isCompleted = true;
+                this->_asyncWaitHandle.set();
+                continuations.swap(this->_continuations);
+            }
+
+            for (auto &continuation : continuations)
+                continuation.executor->execute(std::move(continuation.work));
+        }
+
+        /**
+         * Runs the continuation through the executor once the operation completes, straight away if it already has
+         * @note Continuations run in the order they were added
+         */
+        void addContinuation(Executor::Work &&continuation, Executor &executor) {
+            {
+                Lock lock(this->_completedMutex);
 
-            this->_isCompleted = true;
-            this->_asyncWaitHandle.set();
+                if (!this->_isCompleted) {
+                    this->_continuations.push_back(Continuation{std::move(continuation), &executor});
+                    return;
+                }
+            }
+
+            executor.execute(std::move(continuation));
         }
 
     private:
+        /** A continuation waiting for the operation to complete */
+        struct Continuation {
+            Executor::Work work;
+            Executor *executor;
+        };
+
         Mutex _completedMutex;
+        std::vector<Continuation> _continuations;
         AsyncWaitHandleImpl _asyncWaitHandle;
 
         GenericObject _returnedValue;
@@ -80,6 +114,21 @@ namespace Venus::Utility::Threading {
          */
         GenericObject getTaskResultObject();
 
+        /**
+         * Runs the continuation through the executor once the task completes
+         * @param continuation The work to run, straight away if the task has already completed
+         * @param executor Where the continuation runs, must outlive the task
+         */
+        void addContinuation(Executor::Work &&continuation, Executor &executor);
+
+        /**
+         * Chains a continuation that runs once the task completes, the task's result can be read from within it
+         * @param continuation The work to run
+         * @param executor Where the continuation runs, must outlive the task
+         * @return A result marked complete once the continuation has run
+         */
+        std::shared_ptr<AsyncResult> then(Executor::Work &&continuation, Executor &executor);
+
     protected:
         std::shared_ptr<AsyncResultSyncData> _syncData{nullptr};
     };
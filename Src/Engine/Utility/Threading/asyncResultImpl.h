@@ -14,6 +14,7 @@ namespace Venus::Core {
      */
     class QueuedCommand;
 
+    class CoreThread;
 }
 namespace Venus::Utility::Threading {
     /**
@@ -22,6 +23,7 @@ namespace Venus::Utility::Threading {
     template<class ReturnType>
     class AsyncResultImpl : public AsyncResult {
         friend Venus::Core::QueuedCommand;
+        friend Venus::Core::CoreThread;
     public:
         AsyncResultImpl() = default;
 
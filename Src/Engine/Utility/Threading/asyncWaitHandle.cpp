@@ -2,15 +2,80 @@
 // Created by Kelvin Macartney on 27/04/2020.
 //
 #include "asyncWaitHandle.h"
-#include "TaskScheduler/taskScheduler.h"
+#include "threadPool.h"
+#include "executor.h"
+#include "fiber.h"
+#include "trace.h"
+#include <utility>
 
 void Venus::Utility::Threading::AsyncWaitHandle::wait()  {
-    Lock lock(this->_handleOpenLock);
+    if (this->_handleOpen)
+        return;
+
+    TraceScope trace(TraceEventType::Wait, "Wait");
+
+    if (Fiber::current() != nullptr) {
+        this->_waitOnFiber();
+        return;
+    }
+
+    if (!ThreadPool::isWorkerThread()) {
+        Lock lock(this->_handleOpenLock);
+
+        while (!this->_handleOpen)
+            _handleOpenSignal.wait(lock);
 
+        return;
+    }
+
+    // Blocking a worker takes it out of the pool, so it runs other pending work until the handle is set instead
     while (!this->_handleOpen) {
-        TaskScheduler::instance()->addWorker();
-        _handleOpenSignal.wait(lock);
-        TaskScheduler::instance()->addWorker();
+        if (ThreadPool::runPendingWork())
+            continue;
+
+        // Nothing to run, the work being waited on is running elsewhere. Work queued while we sleep is only picked
+        // up by the sleeping worker once the interval expires, so the wait cannot starve a pool of busy waiters
+        Lock lock(this->_handleOpenLock);
+        _handleOpenSignal.wait_for(lock, ASYNC_WAIT_HELP_INTERVAL, [this]() { return this->_handleOpen.load(); });
+    }
+}
+
+void Venus::Utility::Threading::AsyncWaitHandle::_waitOnFiber() {
+    if (this->_handleOpen)
+        return;
+
+    // Only listed once the fiber has been switched away from, were it listed first the handle could be set and the
+    // fiber resumed on another thread while it is still running on this one
+    Fiber::suspend([this, fiber = Fiber::current()]() {
+        {
+            Lock lock(this->_handleOpenLock);
+
+            if (!this->_handleOpen) {
+                fiber->_nextSuspended = this->_suspendedFibers;
+                this->_suspendedFibers = fiber;
+                return;
+            }
+        }
+
+        Fiber::resume(fiber);
+    });
+}
+
+void Venus::Utility::Threading::AsyncWaitHandle::_resumeSuspendedFibers() {
+    Fiber *fibers;
+
+    {
+        Lock lock(this->_handleOpenLock);
+        fibers = std::exchange(this->_suspendedFibers, nullptr);
+    }
+
+    while (fibers != nullptr) {
+        // Read before the fiber is handed on, it may be resumed and suspend elsewhere straight away
+        Fiber *fiber = std::exchange(fibers, fibers->_nextSuspended);
+
+        // The worker running the awaited task picks up the first waiter itself, the rest go through the pool
+        if (!ThreadPool::resumeAfterCurrentTask(fiber))
+            ThreadPoolExecutor::instance().execute([fiber]() { Fiber::resume(fiber); });
     }
 }
 
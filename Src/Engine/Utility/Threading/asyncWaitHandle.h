@@ -7,8 +7,14 @@
 
 #include "threading.h"
 #include <atomic>
+#include <chrono>
 
 namespace Venus::Utility::Threading {
+    class Fiber;
+
+    /** How long a pool worker with no work to help with sleeps in AsyncWaitHandle::wait() before looking again */
+    static constexpr std::chrono::microseconds ASYNC_WAIT_HELP_INTERVAL{500};
+
     /**
      *  Class allows threads to communicate with each other by signaling. Typically, one or more threads block on an AsyncWaitHandle
      * @
@@ -19,7 +25,12 @@ namespace Venus::Utility::Threading {
 
         ~AsyncWaitHandle() = default;
 
-        /** Waits to be signalled to be set */
+        /**
+         * Waits to be signalled to be set
+         * @note Called on a fiber the fiber is suspended and resumed on the ThreadPool once the handle is set, leaving
+         * the thread free to run other work. Called on a ThreadPool worker the worker runs other pending tasks while
+         * it waits, any other thread blocks.
+         */
         void wait();
 
         /**
@@ -30,10 +41,19 @@ namespace Venus::Utility::Threading {
         bool wait(uint64_t msBeforeTimeout);
 
     protected:
+        /** Suspends the calling fiber until the handle is set */
+        void _waitOnFiber();
+
+        /** Queues every fiber suspended on the handle to be resumed on the ThreadPool */
+        void _resumeSuspendedFibers();
+
         Signal _handleOpenSignal;
         Mutex _handleOpenLock;
 
         std::atomic<bool> _handleOpen{false};
+
+        /** Fibers suspended in wait(), linked through the fibers and guarded by the handle open lock */
+        Fiber *_suspendedFibers{nullptr};
     };
 }
 #endif //VENUS_ASYNCWAITHANDLE_H
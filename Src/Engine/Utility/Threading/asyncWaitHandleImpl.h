@@ -27,6 +27,7 @@ namespace Venus::Utility::Threading {
             }
 
             this->_handleOpenSignal.notify_all();
+            this->_resumeSuspendedFibers();
         }
 
         /**
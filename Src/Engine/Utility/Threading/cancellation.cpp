@@ -0,0 +1,69 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "cancellation.h"
+#include <algorithm>
+
+namespace Venus::Utility::Threading {
+    CancellationSource::CancellationSource()
+            : _state(std::make_shared<CancellationState>()) {}
+
+    CancellationSource::CancellationSource(const std::vector<CancellationToken> &parents)
+            : _state(std::make_shared<CancellationState>()) {
+        for (const auto &parent : parents) {
+            if (parent._state == nullptr)
+                continue;
+
+            {
+                Lock lock(parent._state->mutex);
+
+                // Checked under the lock, a parent cancelled after it is checked walks this child
+                if (!parent._state->cancelled.load(std::memory_order_relaxed)) {
+                    auto &children = parent._state->children;
+
+                    // Short lived children of a long lived parent would otherwise pile up
+                    if (children.size() >= parent._state->pruneThreshold) {
+                        std::erase_if(children, [](const auto &child) { return child.expired(); });
+                        parent._state->pruneThreshold = std::max<size_t>(children.size() * 2, 8);
+                    }
+
+                    children.push_back(this->_state);
+                    continue;
+                }
+            }
+
+            this->cancel();
+        }
+    }
+
+    CancellationToken CancellationSource::getToken() const {
+        return CancellationToken(this->_state);
+    }
+
+    void CancellationSource::cancel() {
+        CancellationSource::_cancelState(this->_state);
+    }
+
+    bool CancellationSource::isCancellationRequested() const {
+        return this->_state->cancelled.load(std::memory_order_acquire);
+    }
+
+    void CancellationSource::_cancelState(const std::shared_ptr<CancellationState> &state) {
+        std::vector<std::weak_ptr<CancellationState>> children;
+
+        {
+            Lock lock(state->mutex);
+
+            if (state->cancelled.exchange(true, std::memory_order_acq_rel))
+                return;
+
+            children = std::move(state->children);
+        }
+
+        for (const auto &child : children) {
+            if (auto childState = child.lock())
+                CancellationSource::_cancelState(childState);
+        }
+    }
+}
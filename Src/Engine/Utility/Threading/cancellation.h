@@ -0,0 +1,96 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_CANCELLATION_H
+#define VENUS_CANCELLATION_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "threading.h"
+
+namespace Venus::Utility::Threading {
+    /** State shared by a cancellation source and its tokens */
+    struct CancellationState {
+        std::atomic_bool cancelled{false};
+
+        /** Guards the children */
+        Mutex mutex;
+
+        /** States of the sources linked to this one, cancelled along with it */
+        std::vector<std::weak_ptr<CancellationState>> children;
+
+        /** Number of children at which the expired ones are next pruned */
+        size_t pruneThreshold{8};
+    };
+
+    /**
+     * Observes whether the work it was handed with should stop.
+     *
+     * Tokens are handed to tasks, pooled work and reads, which are skipped if the token is cancelled before they start.
+     * Long running work polls isCancellationRequested() and returns early once it is set.
+     *
+     * @note A default constructed token is never cancelled
+     * @note Cheap to copy, thread safe
+     */
+    class CancellationToken {
+    public:
+        CancellationToken() = default;
+
+        /** Returns true once cancellation has been requested through the token's source */
+        [[nodiscard]] bool isCancellationRequested() const {
+            return this->_state != nullptr && this->_state->cancelled.load(std::memory_order_acquire);
+        }
+
+        /** Returns true if the token was handed out by a source, and so may be cancelled */
+        [[nodiscard]] bool canBeCancelled() const {
+            return this->_state != nullptr;
+        }
+
+    private:
+        friend class CancellationSource;
+
+        explicit CancellationToken(std::shared_ptr<CancellationState> state)
+                : _state(std::move(state)) {}
+
+        std::shared_ptr<CancellationState> _state{nullptr};
+    };
+
+    /**
+     * Requests cancellation of the work holding its tokens.
+     *
+     * A source may be linked to parent tokens, it is cancelled as soon as any of them is. A task group links the
+     * tokens of its tasks to the group's token this way, so cancelling the group cancels every task in it.
+     *
+     * @note Thread safe, cancelling more than once has no further effect
+     */
+    class CancellationSource {
+    public:
+        /** Creates a source that is only cancelled by calling cancel() */
+        CancellationSource();
+
+        /**
+         * Creates a source that is also cancelled when any of the parents is
+         * @note Cancelled straight away if one of the parents already is
+         */
+        explicit CancellationSource(const std::vector<CancellationToken> &parents);
+
+        /** Returns a token observing this source */
+        [[nodiscard]] CancellationToken getToken() const;
+
+        /** Requests cancellation, cancelling the sources linked to this one too */
+        void cancel();
+
+        /** Returns true once cancellation has been requested */
+        [[nodiscard]] bool isCancellationRequested() const;
+
+    private:
+        /** Sets the state's flag and that of every state linked to it */
+        static void _cancelState(const std::shared_ptr<CancellationState> &state);
+
+        std::shared_ptr<CancellationState> _state;
+    };
+}
+
+#endif //VENUS_CANCELLATION_H
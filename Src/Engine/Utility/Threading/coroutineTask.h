@@ -0,0 +1,255 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_COROUTINETASK_H
+#define VENUS_COROUTINETASK_H
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <utility>
+#include "typedAsyncResult.h"
+
+namespace Venus::Utility::Threading {
+    template<typename ReturnType = void>
+    class CoroutineTask;
+
+    /** Promise state shared by every CoroutineTask specialization */
+    class CoroutineTaskPromiseBase {
+    public:
+        /** Resumes whichever coroutine awaited the task once it finishes */
+        struct FinalAwaitable {
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> coroutine) noexcept {
+                std::coroutine_handle<> continuation = coroutine.promise()._continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        /** Tasks are lazy, they start once awaited or started */
+        std::suspend_always initial_suspend() const noexcept {
+            return {};
+        }
+
+        FinalAwaitable final_suspend() const noexcept {
+            return {};
+        }
+
+        void unhandled_exception() noexcept {
+            this->_exception = std::current_exception();
+        }
+
+        /** Sets the coroutine resumed once the task finishes */
+        void setContinuation(std::coroutine_handle<> continuation) {
+            this->_continuation = continuation;
+        }
+
+    protected:
+        /** Rethrows an exception that escaped the task's body */
+        void _rethrowIfFailed() {
+            if (this->_exception)
+                std::rethrow_exception(this->_exception);
+        }
+
+    private:
+        std::coroutine_handle<> _continuation;
+        std::exception_ptr _exception;
+    };
+
+    /** @copydoc CoroutineTask */
+    template<typename ReturnType>
+    class CoroutineTaskPromise : public CoroutineTaskPromiseBase {
+    public:
+        CoroutineTask<ReturnType> get_return_object();
+
+        template<typename Value>
+        void return_value(Value &&value) {
+            this->_returnedValue.emplace(std::forward<Value>(value));
+        }
+
+        /** Moves the value returned by the task's body out of the promise */
+        ReturnType takeResult() {
+            this->_rethrowIfFailed();
+
+            return std::move(*this->_returnedValue);
+        }
+
+    private:
+        std::optional<ReturnType> _returnedValue;
+    };
+
+    /** @copydoc CoroutineTask */
+    template<>
+    class CoroutineTaskPromise<void> : public CoroutineTaskPromiseBase {
+    public:
+        CoroutineTask<void> get_return_object();
+
+        void return_void() noexcept {}
+
+        /** Rethrows an exception that escaped the task's body */
+        void takeResult() {
+            this->_rethrowIfFailed();
+        }
+    };
+
+    /**
+     * A lazily started coroutine returning a ReturnType. Awaiting a task starts it and resumes the awaiting
+     * coroutine on whichever thread the task finishes on, without blocking either. Combine with
+     * Executor::schedule(), CoreThread::schedule() or ThreadPool::schedule() to hop between threads:
+     *
+     * @code
+     * CoroutineTask<int> load() {
+     *     co_await ThreadPool::instance()->schedule();
+     *     int value = parse();
+     *     co_await getCoreThread()->schedule();
+     *     co_return upload(value);
+     * }
+     * @endcode
+     *
+     * @note Move-only, destroying a task destroys its coroutine, so a started task must be awaited or start()ed
+     */
+    template<typename ReturnType>
+    class CoroutineTask {
+    public:
+        using promise_type = CoroutineTaskPromise<ReturnType>;
+
+        CoroutineTask() = default;
+
+        explicit CoroutineTask(std::coroutine_handle<promise_type> coroutine)
+                : _coroutine(coroutine) {}
+
+        CoroutineTask(CoroutineTask &&other) noexcept
+                : _coroutine(std::exchange(other._coroutine, nullptr)) {}
+
+        CoroutineTask &operator=(CoroutineTask &&other) noexcept {
+            if (this != &other) {
+                this->_destroy();
+                this->_coroutine = std::exchange(other._coroutine, nullptr);
+            }
+
+            return *this;
+        }
+
+        CoroutineTask(const CoroutineTask &) = delete;
+
+        CoroutineTask &operator=(const CoroutineTask &) = delete;
+
+        ~CoroutineTask() {
+            this->_destroy();
+        }
+
+        /** Awaiter starting the task and resuming the awaiting coroutine once it finishes */
+        class Awaitable {
+        public:
+            explicit Awaitable(std::coroutine_handle<promise_type> coroutine)
+                    : _coroutine(coroutine) {}
+
+            bool await_ready() const noexcept {
+                return !this->_coroutine || this->_coroutine.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                this->_coroutine.promise().setContinuation(awaiting);
+                return this->_coroutine;
+            }
+
+            ReturnType await_resume() {
+                return this->_coroutine.promise().takeResult();
+            }
+
+        private:
+            std::coroutine_handle<promise_type> _coroutine;
+        };
+
+        Awaitable operator co_await() &&noexcept {
+            return Awaitable(this->_coroutine);
+        }
+
+        Awaitable operator co_await() &noexcept {
+            return Awaitable(this->_coroutine);
+        }
+
+        /**
+         * Starts the task from code that is not a coroutine
+         * @return A result completed with the task's value once it finishes, on whichever thread it finishes on. An
+         * exception escaping the task's body fails the result instead.
+         */
+        std::shared_ptr<TypedAsyncResult<ReturnType>> start() && {
+            auto result = std::make_shared<TypedAsyncResult<ReturnType>>();
+            CoroutineTask::_complete(std::move(*this), result);
+
+            return result;
+        }
+
+    private:
+        /** Coroutine that starts straight away and destroys itself once it finishes */
+        struct DetachedCoroutine {
+            struct promise_type {
+                DetachedCoroutine get_return_object() noexcept {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() const noexcept {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() const noexcept {
+                    return {};
+                }
+
+                void return_void() noexcept {}
+
+                void unhandled_exception() noexcept {
+                    // The task's own exceptions are stored in its result, only completing the result can throw here
+                    std::terminate();
+                }
+            };
+        };
+
+        /** Runs the task to completion and stores its value, or the exception it threw, in the result */
+        static DetachedCoroutine _complete(CoroutineTask task, std::shared_ptr<TypedAsyncResult<ReturnType>> result) {
+            std::exception_ptr exception;
+
+            try {
+                if constexpr (std::is_void_v<ReturnType>)
+                    co_await std::move(task);
+                else
+                    result->_returnedValue.emplace(co_await std::move(task));
+            } catch (...) {
+                exception = std::current_exception();
+            }
+
+            // Outside the try, an exception thrown by a continuation must not complete the result a second time
+            if (exception != nullptr)
+                result->_markAsFailed(std::move(exception));
+            else
+                result->_markAsComplete();
+        }
+
+        void _destroy() {
+            if (this->_coroutine)
+                this->_coroutine.destroy();
+        }
+
+        std::coroutine_handle<promise_type> _coroutine;
+    };
+
+    template<typename ReturnType>
+    CoroutineTask<ReturnType> CoroutineTaskPromise<ReturnType>::get_return_object() {
+        return CoroutineTask<ReturnType>(std::coroutine_handle<CoroutineTaskPromise>::from_promise(*this));
+    }
+
+    inline CoroutineTask<void> CoroutineTaskPromise<void>::get_return_object() {
+        return CoroutineTask<void>(std::coroutine_handle<CoroutineTaskPromise>::from_promise(*this));
+    }
+}
+
+#endif //VENUS_COROUTINETASK_H
@@ -0,0 +1,190 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "cpuTopology.h"
+#include "threading.h"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <map>
+#include <utility>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace Venus::Utility::Threading {
+    namespace {
+        /** Reads the first line of a sysfs file, empty if it does not exist */
+        std::string readSysfsLine(const std::string &path) {
+            std::ifstream file(path);
+            std::string line;
+
+            std::getline(file, line);
+            return line;
+        }
+
+        /** Returns the dense index of the key, numbering keys in the order they are first seen */
+        template<typename Key>
+        uint32_t getDenseIndex(std::map<Key, uint32_t> &indices, const Key &key) {
+            return indices.try_emplace(key, static_cast<uint32_t>(indices.size())).first->second;
+        }
+    }
+
+    const CpuTopology &CpuTopology::get() {
+        static const CpuTopology topology;
+        return topology;
+    }
+
+    CpuTopology::CpuTopology() {
+        if (!this->_readSysfs())
+            this->_useFlatTopology();
+    }
+
+    const std::vector<LogicalCpu> &CpuTopology::getCpus() const {
+        return this->_cpus;
+    }
+
+    uint32_t CpuTopology::getLogicalCpuCount() const {
+        return static_cast<uint32_t>(this->_cpus.size());
+    }
+
+    uint32_t CpuTopology::getCoreCount() const {
+        return this->_coreCount;
+    }
+
+    std::vector<std::vector<uint32_t>> CpuTopology::getDomains(CpuDomainKind kind) const {
+        std::vector<std::vector<std::pair<uint32_t, uint32_t>>> ranked;
+        std::vector<uint32_t> siblingsSeen(this->_coreCount, 0);
+
+        // A CPU's rank is the number of its core's siblings before it, sorting on it lists the cores' first CPUs first
+        for (const auto &cpu : this->_cpus) {
+            uint32_t domain = kind == CpuDomainKind::NumaNode ? cpu.numaNode : cpu.lastLevelCache;
+            if (domain >= ranked.size())
+                ranked.resize(domain + 1);
+
+            ranked[domain].emplace_back(siblingsSeen[cpu.core]++, cpu.id);
+        }
+
+        std::vector<std::vector<uint32_t>> domains(ranked.size());
+        for (size_t domain = 0; domain < ranked.size(); ++domain) {
+            std::sort(ranked[domain].begin(), ranked[domain].end());
+
+            for (const auto &[rank, id] : ranked[domain])
+                domains[domain].push_back(id);
+        }
+
+        return domains;
+    }
+
+#if defined(__linux__)
+    bool CpuTopology::_readSysfs() {
+        const std::string cpuRoot = "/sys/devices/system/cpu/";
+        const std::string nodeRoot = "/sys/devices/system/node/";
+
+        auto online = CpuTopology::_parseCpuList(readSysfsLine(cpuRoot + "online"));
+        if (online.empty())
+            return false;
+
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        bool hasAffinity = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+        std::map<uint32_t, uint32_t> cpuToNode;
+        for (uint32_t node : CpuTopology::_parseCpuList(readSysfsLine(nodeRoot + "online"))) {
+            auto nodeCpus = readSysfsLine(nodeRoot + "node" + std::to_string(node) + "/cpulist");
+
+            for (uint32_t cpu : CpuTopology::_parseCpuList(nodeCpus))
+                cpuToNode[cpu] = node;
+        }
+
+        std::map<std::pair<std::string, std::string>, uint32_t> cores;
+        std::map<uint32_t, uint32_t> nodes;
+        std::map<std::string, uint32_t> caches;
+
+        for (uint32_t id : online) {
+            if (hasAffinity && (id >= CPU_SETSIZE || !CPU_ISSET(id, &allowed)))
+                continue;
+
+            const std::string root = cpuRoot + "cpu" + std::to_string(id) + "/";
+            std::string package = readSysfsLine(root + "topology/physical_package_id");
+            std::string coreId = readSysfsLine(root + "topology/core_id");
+
+            // Without a core id the CPU is taken to be a core of its own
+            if (coreId.empty())
+                coreId = "cpu" + std::to_string(id);
+
+            // CPUs sharing the same L3 report the same shared CPU list, when there is no L3 the package is shared
+            std::string cache = "package" + package;
+            for (uint32_t index = 0;; ++index) {
+                const std::string cacheRoot = root + "cache/index" + std::to_string(index) + "/";
+                std::string level = readSysfsLine(cacheRoot + "level");
+                if (level.empty())
+                    break;
+
+                if (level == "3") {
+                    cache = readSysfsLine(cacheRoot + "shared_cpu_list");
+                    break;
+                }
+            }
+
+            auto node = cpuToNode.find(id);
+
+            LogicalCpu cpu;
+            cpu.id = id;
+            cpu.core = getDenseIndex(cores, std::make_pair(package, coreId));
+            cpu.numaNode = getDenseIndex(nodes, node != cpuToNode.end() ? node->second : 0u);
+            cpu.lastLevelCache = getDenseIndex(caches, cache);
+
+            this->_cpus.push_back(cpu);
+        }
+
+        this->_coreCount = static_cast<uint32_t>(cores.size());
+        return !this->_cpus.empty();
+    }
+#else
+    bool CpuTopology::_readSysfs() {
+        return false;
+    }
+#endif
+
+    void CpuTopology::_useFlatTopology() {
+        uint32_t count = std::max(THREAD_HARDWARE_CONCURRENCY, 1u);
+
+        this->_cpus.clear();
+        for (uint32_t id = 0; id < count; ++id)
+            this->_cpus.push_back(LogicalCpu{id, id, 0, 0});
+
+        this->_coreCount = count;
+    }
+
+    std::vector<uint32_t> CpuTopology::_parseCpuList(const std::string &list) {
+        std::vector<uint32_t> cpus;
+        const char *position = list.data();
+        const char *end = list.data() + list.size();
+
+        while (position < end) {
+            uint32_t first = 0;
+            auto parsed = std::from_chars(position, end, first);
+
+            // Malformed, the caller falls back to what it knows
+            if (parsed.ec != std::errc())
+                return {};
+
+            uint32_t last = first;
+            if (parsed.ptr < end && *parsed.ptr == '-') {
+                parsed = std::from_chars(parsed.ptr + 1, end, last);
+                if (parsed.ec != std::errc())
+                    return {};
+            }
+
+            for (uint32_t cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+
+            position = parsed.ptr < end && *parsed.ptr == ',' ? parsed.ptr + 1 : end;
+        }
+
+        return cpus;
+    }
+}
@@ -0,0 +1,85 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_CPUTOPOLOGY_H
+#define VENUS_CPUTOPOLOGY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Venus::Utility::Threading {
+    /** How logical CPUs are grouped into domains */
+    enum class CpuDomainKind : uint8_t {
+        /** CPUs sharing a NUMA node, and so the memory attached to it */
+        NumaNode,
+        /** CPUs sharing a last level (L3) cache */
+        LastLevelCache
+    };
+
+    /** A logical CPU the process may run on */
+    struct LogicalCpu {
+        /** The CPU number used by the OS */
+        uint32_t id{0};
+
+        /** The physical core, shared by hyper threads */
+        uint32_t core{0};
+
+        /** The NUMA node */
+        uint32_t numaNode{0};
+
+        /** The last level cache */
+        uint32_t lastLevelCache{0};
+    };
+
+    /**
+     * The logical CPUs available to the process, with the core, NUMA node and last level cache each belongs to.
+     *
+     * Read from sysfs on Linux, limited to the CPUs that are online and in the process' affinity mask. Anything that
+     * cannot be read falls back to every CPU being its own core within a single domain, which is also the topology
+     * reported on other platforms.
+     *
+     * @note Cores, nodes and caches are numbered from 0 in the order they are first seen, not by their OS ids
+     */
+    class CpuTopology {
+    public:
+        /** Returns the topology of the machine, read on first use */
+        static const CpuTopology &get();
+
+        /** Returns the logical CPUs in ascending order of id */
+        [[nodiscard]] const std::vector<LogicalCpu> &getCpus() const;
+
+        /** Returns the number of logical CPUs */
+        [[nodiscard]] uint32_t getLogicalCpuCount() const;
+
+        /** Returns the number of physical cores */
+        [[nodiscard]] uint32_t getCoreCount() const;
+
+        /**
+         * Groups the logical CPUs by domain
+         * @param kind What the CPUs of a domain share
+         * @return The CPU ids of each domain, the first CPU of each core listed before any of their siblings so
+         * spreading work over a domain from the front uses every core before doubling up on one
+         */
+        [[nodiscard]] std::vector<std::vector<uint32_t>> getDomains(CpuDomainKind kind) const;
+
+    private:
+        /** Reads the topology of the machine */
+        CpuTopology();
+
+        /** Reads the topology from sysfs, returns false if the CPUs could not be listed */
+        bool _readSysfs();
+
+        /** Falls back to one core per CPU in a single domain */
+        void _useFlatTopology();
+
+        /** Parses a list of CPUs as written by the kernel, e.g. "0-3,8,10-11" */
+        static std::vector<uint32_t> _parseCpuList(const std::string &list);
+
+        std::vector<LogicalCpu> _cpus;
+        uint32_t _coreCount{0};
+    };
+}
+
+#endif //VENUS_CPUTOPOLOGY_H
@@ -0,0 +1,30 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "executor.h"
+#include "threadPool.h"
+#include <memory>
+
+namespace Venus::Utility::Threading {
+    InlineExecutor &InlineExecutor::instance() {
+        static InlineExecutor executor;
+        return executor;
+    }
+
+    void InlineExecutor::execute(Work &&work) {
+        work();
+    }
+
+    ThreadPoolExecutor &ThreadPoolExecutor::instance() {
+        static ThreadPoolExecutor executor;
+        return executor;
+    }
+
+    void ThreadPoolExecutor::execute(Work &&work) {
+        // The pool takes copyable work, so the move-only work is shared with the copies
+        ThreadPool::instance()->queueWork([work = std::make_shared<Work>(std::move(work))]() {
+            (*work)();
+        });
+    }
+}
@@ -0,0 +1,80 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_EXECUTOR_H
+#define VENUS_EXECUTOR_H
+
+#include <Helpers/inlineFunction.h>
+#include <coroutine>
+
+namespace Venus::Utility::Threading {
+    /**
+     * Decides where a piece of work, such as an async result's continuation, runs.
+     *
+     * @note Executors are long lived and passed by reference, use the instance() of one of the implementations
+     */
+    class Executor {
+    public:
+        /** Work accepted by an executor, stored inline if its captures fit */
+        using Work = InlineFunction<void()>;
+
+        virtual ~Executor() = default;
+
+        /**
+         * Runs or schedules the work
+         * @param work The work, ownership is taken by the executor
+         */
+        virtual void execute(Work &&work) = 0;
+
+        /** Awaitable that resumes the awaiting coroutine through an executor */
+        class ScheduleAwaitable {
+        public:
+            explicit ScheduleAwaitable(Executor &executor)
+                    : _executor(executor) {}
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> coroutine) {
+                this->_executor.execute([coroutine]() { coroutine.resume(); });
+            }
+
+            void await_resume() const noexcept {}
+
+        private:
+            Executor &_executor;
+        };
+
+        /**
+         * Returns an awaitable that moves the awaiting coroutine onto this executor, use as
+         * `co_await executor.schedule()`
+         */
+        ScheduleAwaitable schedule() {
+            return ScheduleAwaitable(*this);
+        }
+    };
+
+    /** Runs work immediately on the calling thread, for a continuation that is the thread completing the result */
+    class InlineExecutor final : public Executor {
+    public:
+        /** Returns the global inline executor */
+        static InlineExecutor &instance();
+
+        /** @copydoc Executor::execute */
+        void execute(Work &&work) override;
+    };
+
+    /** Queues work on the ThreadPool */
+    class ThreadPoolExecutor final : public Executor {
+    public:
+        /** Returns the global thread pool executor */
+        static ThreadPoolExecutor &instance();
+
+        /** @copydoc Executor::execute */
+        void execute(Work &&work) override;
+    };
+}
+
+#endif //VENUS_EXECUTOR_H
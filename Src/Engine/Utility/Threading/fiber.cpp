@@ -0,0 +1,211 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "fiber.h"
+#include <Error/venusExceptions.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Venus::Utility::Threading {
+    namespace {
+        std::atomic<size_t> fiberStackSize{FIBER_DEFAULT_STACK_SIZE};
+
+        /** The fiber running on this thread */
+        thread_local Fiber *currentFiber = nullptr;
+
+        /** Finished fibers kept for reuse, freed with the thread */
+        struct FiberCache {
+            ~FiberCache() {
+                for (Fiber *fiber : this->fibers)
+                    delete fiber;
+            }
+
+            std::vector<Fiber *> fibers;
+        };
+
+        thread_local FiberCache fiberCache;
+    }
+
+#if defined(__linux__)
+    namespace {
+        size_t getPageSize() {
+            static const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            return pageSize;
+        }
+    }
+
+    Fiber::Fiber(size_t stackSize)
+            : _stackSize((stackSize + getPageSize() - 1) / getPageSize() * getPageSize()) {
+        // The lowest page is left inaccessible, so overflowing the stack faults instead of corrupting the heap
+        size_t mappedSize = this->_stackSize + getPageSize();
+        this->_stack = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1,
+                            0);
+
+        if (this->_stack == MAP_FAILED)
+            VENUS_EXCEPT(InternalErrorException, "Failed to allocate a fiber stack");
+
+        if (mprotect(this->_stack, getPageSize(), PROT_NONE) != 0) {
+            munmap(this->_stack, mappedSize);
+            VENUS_EXCEPT(InternalErrorException, "Failed to protect a fiber stack's guard page");
+        }
+
+        getcontext(&this->_context);
+        this->_context.uc_stack.ss_sp = static_cast<char *>(this->_stack) + getPageSize();
+        this->_context.uc_stack.ss_size = this->_stackSize;
+        this->_context.uc_link = nullptr;
+
+        // makecontext only passes int arguments, so the fiber's address is split in two
+        auto address = reinterpret_cast<uintptr_t>(this);
+        makecontext(&this->_context, reinterpret_cast<void (*)()>(&Fiber::_entry), 2,
+                    static_cast<uint32_t>(static_cast<uint64_t>(address) >> 32), static_cast<uint32_t>(address));
+    }
+
+    Fiber::~Fiber() {
+        munmap(this->_stack, this->_stackSize + getPageSize());
+    }
+
+    bool Fiber::isSupported() {
+        return true;
+    }
+
+    void Fiber::run(Work &&work) {
+        Fiber *fiber = Fiber::_acquire();
+
+        fiber->_work = std::move(work);
+        fiber->_finished = false;
+
+        Fiber::_switchTo(fiber);
+    }
+
+    void Fiber::resume(Fiber *fiber) {
+        Fiber::_switchTo(fiber);
+    }
+
+    void Fiber::suspend(Work &&afterSuspend) {
+        Fiber *fiber = currentFiber;
+        if (fiber == nullptr)
+            VENUS_EXCEPT(InvalidOperationException, "Only code running on a fiber can suspend");
+
+        fiber->_afterSuspend = std::move(afterSuspend);
+        fiber->_switchOut();
+    }
+
+    void Fiber::_entry(uint32_t fiberHigh, uint32_t fiberLow) {
+        auto *fiber = reinterpret_cast<Fiber *>((static_cast<uintptr_t>(fiberHigh) << 32) | fiberLow);
+
+        // Never returns, a finished fiber waits here to be handed its next piece of work
+        while (true) {
+            fiber->_work();
+            fiber->_work = nullptr;
+
+            fiber->_finished = true;
+            fiber->_switchOut();
+        }
+    }
+
+    void Fiber::_switchTo(Fiber *fiber) {
+        // Lives on this thread's stack, the fiber switches back to it on this thread whether it finishes or suspends
+        ucontext_t returnContext;
+
+        Fiber *previous = currentFiber;
+        currentFiber = fiber;
+
+        fiber->_returnContext = &returnContext;
+        swapcontext(&returnContext, &fiber->_context);
+
+        currentFiber = previous;
+
+        if (fiber->_finished) {
+            Fiber::_release(fiber);
+            return;
+        }
+
+        if (fiber->_afterSuspend) {
+            Work afterSuspend = std::move(fiber->_afterSuspend);
+            fiber->_afterSuspend = nullptr;
+
+            // The fiber may be resumed on another thread from here on
+            afterSuspend();
+        }
+    }
+
+    void Fiber::_switchOut() {
+        swapcontext(&this->_context, this->_returnContext);
+    }
+#else
+    Fiber::Fiber(size_t stackSize)
+            : _stackSize(stackSize) {}
+
+    Fiber::~Fiber() = default;
+
+    bool Fiber::isSupported() {
+        return false;
+    }
+
+    void Fiber::run(Work &&work) {
+        work();
+    }
+
+    void Fiber::resume([[maybe_unused]] Fiber *fiber) {
+        VENUS_EXCEPT(NotImplementedException, "Fibers are not supported on this platform");
+    }
+
+    void Fiber::suspend([[maybe_unused]] Work &&afterSuspend) {
+        VENUS_EXCEPT(NotImplementedException, "Fibers are not supported on this platform");
+    }
+
+    void Fiber::_entry([[maybe_unused]] uint32_t fiberHigh, [[maybe_unused]] uint32_t fiberLow) {}
+
+    void Fiber::_switchTo([[maybe_unused]] Fiber *fiber) {}
+
+    void Fiber::_switchOut() {}
+#endif
+
+    Fiber *Fiber::current() {
+        return currentFiber;
+    }
+
+    void Fiber::setStackSize(size_t stackSize) {
+        fiberStackSize.store(stackSize, std::memory_order_relaxed);
+    }
+
+    size_t Fiber::getStackSize() {
+        return fiberStackSize.load(std::memory_order_relaxed);
+    }
+
+    Fiber *Fiber::_acquire() {
+        auto &fibers = fiberCache.fibers;
+        size_t stackSize = Fiber::getStackSize();
+
+        while (!fibers.empty()) {
+            Fiber *fiber = fibers.back();
+            fibers.pop_back();
+
+            if (fiber->_stackSize >= stackSize)
+                return fiber;
+
+            // Created before the stack size was raised
+            delete fiber;
+        }
+
+        return new Fiber(stackSize);
+    }
+
+    void Fiber::_release(Fiber *fiber) {
+        auto &fibers = fiberCache.fibers;
+
+        if (fibers.size() >= FIBER_THREAD_CACHE_SIZE) {
+            delete fiber;
+            return;
+        }
+
+        fibers.push_back(fiber);
+    }
+}
@@ -0,0 +1,126 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_FIBER_H
+#define VENUS_FIBER_H
+
+#include <Helpers/inlineFunction.h>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <ucontext.h>
+#endif
+
+namespace Venus::Utility::Threading {
+    /** Default size of a fiber's stack, fibers run short tasks and anything deeper belongs on a thread */
+    static constexpr size_t FIBER_DEFAULT_STACK_SIZE = 64 * 1024;
+
+    /**
+     * Number of finished fibers each thread keeps around for reuse, any more are freed. Stacks are only backed by
+     * memory as deep as they have been used, so a cached fiber costs little more than its mapping.
+     */
+    static constexpr uint32_t FIBER_THREAD_CACHE_SIZE = 1024;
+
+    class AsyncWaitHandle;
+
+    /**
+     * A user space thread of execution with its own small stack, switched to and from without involving the kernel.
+     *
+     * Work is started on a fiber taken from the calling thread's cache, the thread returns once the work either
+     * finishes or suspends. A suspended fiber is resumed by whichever thread calls resume(), so a fiber waiting on
+     * a dependency does not tie up the thread it started on.
+     *
+     * @note Only supported on Linux, where the context switch uses ucontext. Elsewhere isSupported() returns false and
+     * run() executes the work directly on the calling thread.
+     * @note Thread locals read on a fiber before a suspend may belong to a different thread after it, read them again
+     * through a function call rather than holding on to them.
+     */
+    class Fiber {
+    public:
+        /** Work run on a fiber, or run once a fiber has been switched away from */
+        using Work = InlineFunction<void()>;
+
+        Fiber(const Fiber &) = delete;
+
+        Fiber &operator=(const Fiber &) = delete;
+
+        ~Fiber();
+
+        /** Returns true if fibers are supported on this platform */
+        static bool isSupported();
+
+        /**
+         * Runs the work on a fiber, returning once it has finished or suspended
+         * @param work The work
+         */
+        static void run(Work &&work);
+
+        /** Returns the fiber running on the calling thread, nullptr if the thread is not running a fiber */
+        static Fiber *current();
+
+        /**
+         * Suspends the calling fiber and switches back to the thread that started or resumed it
+         * @param afterSuspend Run by that thread once the fiber has been switched away from, the earliest point the
+         * fiber may be handed to resume()
+         * @note Must be called on a fiber, returns once the fiber has been resumed
+         */
+        static void suspend(Work &&afterSuspend);
+
+        /**
+         * Switches to the suspended fiber on the calling thread, returning once it has finished or suspended again
+         * @param fiber The fiber
+         */
+        static void resume(Fiber *fiber);
+
+        /**
+         * Sets the stack size of fibers created from now on
+         * @param stackSize The stack size in bytes, rounded up to whole pages
+         */
+        static void setStackSize(size_t stackSize);
+
+        /** Returns the stack size of newly created fibers */
+        static size_t getStackSize();
+
+    private:
+        friend class AsyncWaitHandle;
+
+        /** Creates a fiber with a stack of the given size */
+        explicit Fiber(size_t stackSize);
+
+        /** Entry point of a fiber's context, runs the fiber's work each time it is reused */
+        static void _entry(uint32_t fiberHigh, uint32_t fiberLow);
+
+        /** Switches to the fiber, then recycles it if it finished or runs its after suspend work */
+        static void _switchTo(Fiber *fiber);
+
+        /** Switches from the running fiber back to the context that switched to it */
+        void _switchOut();
+
+        /** Returns a fiber from the calling thread's cache, creating one if the cache is empty */
+        static Fiber *_acquire();
+
+        /** Returns a finished fiber to the calling thread's cache */
+        static void _release(Fiber *fiber);
+
+        Work _work;
+        Work _afterSuspend;
+        bool _finished{false};
+
+        /** The next fiber suspended on the same wait handle */
+        Fiber *_nextSuspended{nullptr};
+
+        void *_stack{nullptr};
+        const size_t _stackSize{0};
+
+#if defined(__linux__)
+        ucontext_t _context{};
+
+        /** Where the fiber switches to when it suspends or finishes, set every time the fiber is switched to */
+        ucontext_t *_returnContext{nullptr};
+#endif
+    };
+}
+
+#endif //VENUS_FIBER_H
@@ -0,0 +1,48 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_FUTEX_H
+#define VENUS_FUTEX_H
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Venus::Utility::Threading {
+    /**
+     * Blocks the calling thread while the word holds the expected value, or until woken by futexWake
+     * @note May return spuriously, callers check the word again in a loop
+     * @note A futex on Linux, elsewhere std::atomic wait
+     */
+    inline void futexWait(std::atomic_uint32_t &word, uint32_t expected) {
+#if defined(__linux__)
+        static_assert(sizeof(std::atomic_uint32_t) == sizeof(uint32_t));
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+        word.wait(expected, std::memory_order_acquire);
+#endif
+    }
+
+    /**
+     * Wakes threads blocked in futexWait on the word
+     * @param count The most threads woken
+     */
+    inline void futexWake(std::atomic_uint32_t &word, uint32_t count) {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+        if (count == 1)
+            word.notify_one();
+        else
+            word.notify_all();
+#endif
+    }
+}
+
+#endif //VENUS_FUTEX_H
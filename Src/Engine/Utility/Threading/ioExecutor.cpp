@@ -0,0 +1,531 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "ioExecutor.h"
+#include "venusThread.h"
+#include "trace.h"
+#include <Error/venusExceptions.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define VENUS_IO_URING
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace Venus::Utility::Threading {
+    struct IoExecutor::ReadRequest {
+        std::string path;
+        uint64_t offset{0};
+        uint32_t size{0};
+        CancellationToken cancellation;
+
+        std::shared_ptr<TypedAsyncResult<IoBuffer>> result;
+        IoBuffer buffer;
+        int file{-1};
+
+        /** Bytes read so far, a short read is continued from here */
+        uint32_t bytesRead{0};
+
+#if defined(VENUS_IO_URING)
+        iovec vector{};
+#endif
+    };
+
+#if defined(VENUS_IO_URING)
+    namespace {
+        /** Marks the completion of the poll on the wake eventfd, reads carry their request */
+        constexpr uint64_t WAKE_POLL_USER_DATA = 0;
+
+        int ioUringSetup(uint32_t entries, io_uring_params &params) {
+            return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        }
+
+        int ioUringEnter(int ring, uint32_t toSubmit, uint32_t minimumComplete, uint32_t flags) {
+            return static_cast<int>(syscall(__NR_io_uring_enter, ring, toSubmit, minimumComplete, flags, nullptr, 0));
+        }
+
+        /** Loads a ring index written by the kernel */
+        uint32_t loadAcquire(uint32_t *index) {
+            return std::atomic_ref<uint32_t>(*index).load(std::memory_order_acquire);
+        }
+
+        /** Stores a ring index read by the kernel */
+        void storeRelease(uint32_t *index, uint32_t value) {
+            std::atomic_ref<uint32_t>(*index).store(value, std::memory_order_release);
+        }
+    }
+
+    struct IoExecutor::Ring {
+        /**
+         * Sets up an io_uring with room for the given number of reads and the wake poll
+         * @return nullptr if the kernel does not support io_uring or it is disabled
+         */
+        static std::unique_ptr<Ring> create(uint32_t queueDepth) {
+            auto ring = std::make_unique<Ring>();
+            ring->queueDepth = std::max(queueDepth, 1u);
+
+            io_uring_params params{};
+            ring->file = ioUringSetup(ring->queueDepth + 1, params);
+            if (ring->file < 0)
+                return nullptr;
+
+            ring->submissionSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+            ring->completionSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+            // Older kernels map the two rings separately
+            bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMapping)
+                ring->submissionSize = ring->completionSize = std::max(ring->submissionSize, ring->completionSize);
+
+            ring->submissionMapping = mmap(nullptr, ring->submissionSize, PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE, ring->file, IORING_OFF_SQ_RING);
+            if (ring->submissionMapping == MAP_FAILED)
+                return nullptr;
+
+            ring->completionMapping = singleMapping
+                                      ? ring->submissionMapping
+                                      : mmap(nullptr, ring->completionSize, PROT_READ | PROT_WRITE,
+                                             MAP_SHARED | MAP_POPULATE, ring->file, IORING_OFF_CQ_RING);
+            if (ring->completionMapping == MAP_FAILED)
+                return nullptr;
+
+            ring->entriesSize = params.sq_entries * sizeof(io_uring_sqe);
+            ring->entriesMapping = mmap(nullptr, ring->entriesSize, PROT_READ | PROT_WRITE,
+                                        MAP_SHARED | MAP_POPULATE, ring->file, IORING_OFF_SQES);
+            if (ring->entriesMapping == MAP_FAILED)
+                return nullptr;
+
+            auto *submission = static_cast<char *>(ring->submissionMapping);
+            ring->submissionHead = reinterpret_cast<uint32_t *>(submission + params.sq_off.head);
+            ring->submissionTail = reinterpret_cast<uint32_t *>(submission + params.sq_off.tail);
+            ring->submissionMask = *reinterpret_cast<uint32_t *>(submission + params.sq_off.ring_mask);
+            ring->submissionArray = reinterpret_cast<uint32_t *>(submission + params.sq_off.array);
+            ring->submissionEntries = params.sq_entries;
+            ring->entries = static_cast<io_uring_sqe *>(ring->entriesMapping);
+
+            auto *completion = static_cast<char *>(ring->completionMapping);
+            ring->completionHead = reinterpret_cast<uint32_t *>(completion + params.cq_off.head);
+            ring->completionTail = reinterpret_cast<uint32_t *>(completion + params.cq_off.tail);
+            ring->completionMask = *reinterpret_cast<uint32_t *>(completion + params.cq_off.ring_mask);
+            ring->completions = reinterpret_cast<io_uring_cqe *>(completion + params.cq_off.cqes);
+
+            ring->wakeFile = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (ring->wakeFile < 0)
+                return nullptr;
+
+            return ring;
+        }
+
+        ~Ring() {
+            if (this->entriesMapping != MAP_FAILED)
+                munmap(this->entriesMapping, this->entriesSize);
+
+            if (this->completionMapping != MAP_FAILED && this->completionMapping != this->submissionMapping)
+                munmap(this->completionMapping, this->completionSize);
+
+            if (this->submissionMapping != MAP_FAILED)
+                munmap(this->submissionMapping, this->submissionSize);
+
+            if (this->wakeFile >= 0)
+                close(this->wakeFile);
+
+            if (this->file >= 0)
+                close(this->file);
+        }
+
+        /** Returns the next free submission entry, cleared, to be filled and then pushed */
+        io_uring_sqe &nextEntry() {
+            uint32_t tail = *this->submissionTail;
+            if (tail - loadAcquire(this->submissionHead) >= this->submissionEntries)
+                VENUS_EXCEPT(InternalErrorException, "The io_uring submission queue is full");
+
+            io_uring_sqe &entry = this->entries[tail & this->submissionMask];
+            entry = io_uring_sqe{};
+
+            return entry;
+        }
+
+        /** Publishes the entry returned by nextEntry() to the kernel */
+        void pushEntry() {
+            uint32_t tail = *this->submissionTail;
+            uint32_t index = tail & this->submissionMask;
+
+            this->submissionArray[index] = index;
+            storeRelease(this->submissionTail, tail + 1);
+            ++this->unsubmitted;
+        }
+
+        int file{-1};
+        int wakeFile{-1};
+        uint32_t queueDepth{0};
+
+        void *submissionMapping{MAP_FAILED};
+        size_t submissionSize{0};
+        void *completionMapping{MAP_FAILED};
+        size_t completionSize{0};
+        void *entriesMapping{MAP_FAILED};
+        size_t entriesSize{0};
+
+        uint32_t *submissionHead{nullptr};
+        uint32_t *submissionTail{nullptr};
+        uint32_t submissionMask{0};
+        uint32_t *submissionArray{nullptr};
+        uint32_t submissionEntries{0};
+        io_uring_sqe *entries{nullptr};
+
+        uint32_t *completionHead{nullptr};
+        uint32_t *completionTail{nullptr};
+        uint32_t completionMask{0};
+        io_uring_cqe *completions{nullptr};
+
+        /** Only touched by the I/O thread */
+        uint32_t unsubmitted{0};
+        uint32_t readsInFlight{0};
+    };
+#else
+    struct IoExecutor::Ring {
+        static std::unique_ptr<Ring> create(uint32_t queueDepth) {
+            return nullptr;
+        }
+    };
+#endif
+
+    IoExecutor::IoExecutor() = default;
+
+    IoExecutor::IoExecutor(const IoExecutorDescription &description)
+            : _description(description) {}
+
+    IoExecutor::~IoExecutor() = default;
+
+    void IoExecutor::ignition() {
+        if (this->_description.enableIoUring)
+            this->_ring = Ring::create(this->_description.queueDepth);
+
+        if (this->_ring != nullptr)
+            this->_threads.push_back(std::make_unique<VenusThread>([this] { this->_runRingThread(); }));
+        else if (this->_description.enableIoUring)
+            spdlog::info("io_uring is unavailable, file reads run on blocking I/O threads");
+
+        uint32_t blockingThreads = std::max(this->_description.blockingThreads, 1u);
+        for (uint32_t i = 0; i < blockingThreads; ++i)
+            this->_threads.push_back(std::make_unique<VenusThread>([this] { this->_runBlockingThread(); }));
+    }
+
+    std::shared_ptr<TypedAsyncResult<IoBuffer>>
+    IoExecutor::read(const std::string &path, uint64_t offset, uint32_t size, const CancellationToken &cancellation) {
+        auto request = std::make_unique<ReadRequest>();
+        request->path = path;
+        request->offset = offset;
+        request->size = size;
+        request->cancellation = cancellation;
+        request->result = std::make_shared<TypedAsyncResult<IoBuffer>>();
+
+        auto result = request->result;
+
+        if (this->_ring == nullptr) {
+            this->execute([request = std::move(request)]() { IoExecutor::_readBlocking(*request); });
+            return result;
+        }
+
+        {
+            Lock lock(this->_mutex);
+
+            if (this->_stopping)
+                VENUS_EXCEPT(InvalidOperationException, "Cannot read through an I/O executor that has shut down");
+
+            this->_waitingReads.push(std::move(request));
+        }
+
+        this->_wakeRingThread();
+        return result;
+    }
+
+    void IoExecutor::execute(Work &&work) {
+        {
+            Lock lock(this->_mutex);
+
+            if (this->_stopping)
+                VENUS_EXCEPT(InvalidOperationException, "Cannot queue work on an I/O executor that has shut down");
+
+            this->_blockingWork.push(std::move(work));
+        }
+
+        this->_workAvailable.notify_one();
+    }
+
+    bool IoExecutor::isUsingIoUring() const {
+        return this->_ring != nullptr;
+    }
+
+    void IoExecutor::shutdown() {
+        {
+            Lock lock(this->_mutex);
+            this->_stopping = true;
+        }
+
+        this->_workAvailable.notify_all();
+
+        if (this->_ring != nullptr)
+            this->_wakeRingThread();
+
+        for (auto &thread : this->_threads)
+            thread->join();
+
+        this->_threads.clear();
+    }
+
+    void IoExecutor::_runBlockingThread() {
+        Tracer::setThreadName(IO_THREAD_NAME_PREFIX "Blocking");
+
+        while (true) {
+            Work work;
+
+            {
+                Lock lock(this->_mutex);
+
+                while (!this->_stopping && this->_blockingWork.empty())
+                    this->_workAvailable.wait(lock);
+
+                // Work queued before the executor stopped still runs
+                if (this->_blockingWork.empty())
+                    return;
+
+                work = std::move(this->_blockingWork.front());
+                this->_blockingWork.pop();
+            }
+
+            work();
+        }
+    }
+
+    void IoExecutor::_readBlocking(ReadRequest &request) {
+        if (IoExecutor::_completeIfCancelled(request))
+            return;
+
+        request.file = open(request.path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (request.file < 0) {
+            request.buffer.error = errno;
+            IoExecutor::_completeRead(request);
+            return;
+        }
+
+        request.buffer.data.resize(request.size);
+
+        while (request.bytesRead < request.size) {
+            ssize_t count = pread(request.file, request.buffer.data.data() + request.bytesRead,
+                                  request.size - request.bytesRead,
+                                  static_cast<off_t>(request.offset + request.bytesRead));
+
+            if (count < 0 && errno == EINTR)
+                continue;
+
+            if (count < 0) {
+                request.buffer.error = errno;
+                break;
+            }
+
+            if (count == 0)
+                break;
+
+            request.bytesRead += static_cast<uint32_t>(count);
+        }
+
+        IoExecutor::_completeRead(request);
+    }
+
+    bool IoExecutor::_completeIfCancelled(ReadRequest &request) {
+        if (!request.cancellation.isCancellationRequested())
+            return false;
+
+        request.buffer.error = ECANCELED;
+        IoExecutor::_completeRead(request);
+        return true;
+    }
+
+    void IoExecutor::_completeRead(ReadRequest &request) {
+        if (request.file >= 0)
+            close(request.file);
+
+        if (request.buffer.succeeded())
+            request.buffer.data.resize(request.bytesRead);
+        else
+            request.buffer.data.clear();
+
+        request.result->_markAsCompleteWithValue(std::move(request.buffer));
+    }
+
+#if defined(VENUS_IO_URING)
+    void IoExecutor::_runRingThread() {
+        Tracer::setThreadName(IO_THREAD_NAME_PREFIX "Ring");
+
+        Ring &ring = *this->_ring;
+        this->_armWakePoll();
+
+        while (true) {
+            this->_prepareReads();
+
+            if (ring.readsInFlight == 0) {
+                Lock lock(this->_mutex);
+
+                // Stopping wakes this thread, so the check cannot miss it once the thread goes on to wait
+                if (this->_stopping && this->_waitingReads.empty())
+                    return;
+            }
+
+            int submitted = ioUringEnter(ring.file, ring.unsubmitted, 1, IORING_ENTER_GETEVENTS);
+            if (submitted < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                VENUS_EXCEPT(InternalErrorException, "Failed to submit to the io_uring");
+
+            if (submitted > 0)
+                ring.unsubmitted -= static_cast<uint32_t>(submitted);
+
+            this->_reapCompletions();
+        }
+    }
+
+    uint32_t IoExecutor::_prepareReads() {
+        Ring &ring = *this->_ring;
+        uint32_t prepared = 0;
+
+        while (ring.readsInFlight < ring.queueDepth) {
+            std::unique_ptr<ReadRequest> request;
+
+            {
+                Lock lock(this->_mutex);
+
+                if (this->_waitingReads.empty())
+                    break;
+
+                request = std::move(this->_waitingReads.front());
+                this->_waitingReads.pop();
+            }
+
+            if (IoExecutor::_completeIfCancelled(*request))
+                continue;
+
+            // Opening is left to this thread rather than the ring, it rarely blocks for long on a local file
+            request->file = open(request->path.c_str(), O_RDONLY | O_CLOEXEC);
+
+            if (request->file < 0 || request->size == 0) {
+                if (request->file < 0)
+                    request->buffer.error = errno;
+
+                IoExecutor::_completeRead(*request);
+                continue;
+            }
+
+            request->buffer.data.resize(request->size);
+
+            io_uring_sqe &entry = ring.nextEntry();
+            request->vector.iov_base = request->buffer.data.data();
+            request->vector.iov_len = request->size;
+
+            entry.opcode = IORING_OP_READV;
+            entry.fd = request->file;
+            entry.addr = reinterpret_cast<uint64_t>(&request->vector);
+            entry.len = 1;
+            entry.off = request->offset;
+            entry.user_data = reinterpret_cast<uint64_t>(request.release());
+
+            ring.pushEntry();
+            ++ring.readsInFlight;
+            ++prepared;
+        }
+
+        return prepared;
+    }
+
+    void IoExecutor::_reapCompletions() {
+        Ring &ring = *this->_ring;
+
+        uint32_t head = *ring.completionHead;
+        uint32_t tail = loadAcquire(ring.completionTail);
+
+        for (; head != tail; ++head) {
+            const io_uring_cqe &completion = ring.completions[head & ring.completionMask];
+            int32_t bytes = completion.res;
+
+            if (completion.user_data == WAKE_POLL_USER_DATA) {
+                uint64_t count;
+                while (::read(ring.wakeFile, &count, sizeof(count)) > 0) {}
+
+                this->_armWakePoll();
+                continue;
+            }
+
+            auto *request = reinterpret_cast<ReadRequest *>(completion.user_data);
+
+            if (bytes > 0)
+                request->bytesRead += static_cast<uint32_t>(bytes);
+            else if (bytes == 0)
+                request->size = request->bytesRead; // The end of the file
+            else if (bytes != -EINTR && bytes != -EAGAIN)
+                request->buffer.error = -bytes;
+
+            // A short read is continued from where it stopped, the entry freed by this completion makes room
+            if (request->buffer.succeeded() && request->bytesRead < request->size) {
+                io_uring_sqe &entry = ring.nextEntry();
+                request->vector.iov_base = request->buffer.data.data() + request->bytesRead;
+                request->vector.iov_len = request->size - request->bytesRead;
+
+                entry.opcode = IORING_OP_READV;
+                entry.fd = request->file;
+                entry.addr = reinterpret_cast<uint64_t>(&request->vector);
+                entry.len = 1;
+                entry.off = request->offset + request->bytesRead;
+                entry.user_data = completion.user_data;
+
+                ring.pushEntry();
+                continue;
+            }
+
+            --ring.readsInFlight;
+
+            std::unique_ptr<ReadRequest> completed(request);
+            IoExecutor::_completeRead(*completed);
+        }
+
+        storeRelease(ring.completionHead, head);
+    }
+
+    void IoExecutor::_armWakePoll() {
+        Ring &ring = *this->_ring;
+
+        io_uring_sqe &entry = ring.nextEntry();
+        entry.opcode = IORING_OP_POLL_ADD;
+        entry.fd = ring.wakeFile;
+        entry.poll_events = POLLIN;
+        entry.user_data = WAKE_POLL_USER_DATA;
+
+        ring.pushEntry();
+    }
+
+    void IoExecutor::_wakeRingThread() {
+        uint64_t one = 1;
+        while (write(this->_ring->wakeFile, &one, sizeof(one)) < 0 && errno == EINTR) {}
+    }
+#else
+    void IoExecutor::_runRingThread() {}
+
+    uint32_t IoExecutor::_prepareReads() {
+        return 0;
+    }
+
+    void IoExecutor::_reapCompletions() {}
+
+    void IoExecutor::_armWakePoll() {}
+
+    void IoExecutor::_wakeRingThread() {}
+#endif
+}
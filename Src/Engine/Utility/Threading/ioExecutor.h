@@ -0,0 +1,163 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_IOEXECUTOR_H
+#define VENUS_IOEXECUTOR_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "threading.h"
+#include "executor.h"
+#include "typedAsyncResult.h"
+#include "cancellation.h"
+#include <Module.h>
+
+namespace Venus::Utility::Threading {
+    class VenusThread;
+
+    /** Number of reads the io_uring backend keeps in flight at most, further reads wait for one to complete */
+    static constexpr uint32_t IO_DEFAULT_QUEUE_DEPTH = 128;
+
+    /** The bytes read by an asynchronous read */
+    struct IoBuffer {
+        /** The bytes read, fewer than requested if the end of the file was reached */
+        std::vector<uint8_t> data;
+
+        /** The errno the read failed with, 0 if it succeeded */
+        int32_t error{0};
+
+        /** Returns true if the read succeeded */
+        [[nodiscard]] bool succeeded() const {
+            return this->error == 0;
+        }
+    };
+
+    /** Description used to create an I/O executor */
+    struct IoExecutorDescription {
+    public:
+        /** Number of threads running blocking work, and reads when io_uring is not used */
+        uint32_t blockingThreads{2};
+
+        /** Boolean indicating if reads are submitted through io_uring where the kernel supports it */
+        bool enableIoUring{true};
+
+        /** The most reads in flight on the io_uring at once */
+        uint32_t queueDepth{IO_DEFAULT_QUEUE_DEPTH};
+    };
+
+    /**
+     * Runs file I/O and other blocking work on threads of its own, so it never stalls a ThreadPool worker.
+     *
+     * On Linux reads are submitted to an io_uring serviced by a single I/O thread, which opens the files and completes
+     * the results as the kernel finishes the reads. Where io_uring is unavailable, or disabled in the description, the
+     * reads run on the blocking threads with pread instead.
+     *
+     * @note Results are completed on an I/O thread. Continuations are posted back with then(), using the
+     * ThreadPoolExecutor or CoreThreadExecutor; continuations run by the InlineExecutor would run on the I/O thread
+     * and must not block.
+     * @note Thread safe
+     */
+    class IoExecutor final : public Module<IoExecutor>, public Executor {
+    public:
+        IoExecutor();
+
+        /**
+         * Constructor
+         * @param description The executor's description
+         */
+        explicit IoExecutor(const IoExecutorDescription &description);
+
+        /** Starts the I/O threads, setting up the io_uring if it is enabled */
+        void ignition() override;
+
+        /**
+         * Reads part of a file asynchronously
+         * @param path The file's path
+         * @param offset The offset of the first byte read
+         * @param size The number of bytes read, fewer are returned if the end of the file is reached first
+         * @param cancellation Skips the read if cancelled before it is submitted, failing it with ECANCELED
+         * @return A result holding the bytes read, or the error the file could not be opened or read with
+         */
+        std::shared_ptr<TypedAsyncResult<IoBuffer>> read(const std::string &path, uint64_t offset, uint32_t size,
+                                                         const CancellationToken &cancellation = {});
+
+        /**
+         * Runs blocking work on one of the blocking threads
+         * @param work The work, ownership is taken by the executor
+         */
+        void execute(Work &&work) override;
+
+        /** Returns true if reads are submitted through io_uring */
+        [[nodiscard]] bool isUsingIoUring() const;
+
+        /**
+         * Stops the I/O threads once the reads and work already queued have completed
+         * @note Blocking call, joins every I/O thread
+         */
+        void shutdown() override;
+
+        /** Destructor */
+        ~IoExecutor() override;
+
+    private:
+        /** A read waiting for or in flight on the kernel */
+        struct ReadRequest;
+
+        /** The io_uring and the ring buffers it shares with the kernel */
+        struct Ring;
+
+        /** Loop of a blocking thread */
+        void _runBlockingThread();
+
+        /** Loop of the I/O thread servicing the io_uring */
+        void _runRingThread();
+
+        /**
+         * Moves waiting reads onto the submission ring, up to the queue depth
+         * @return The number of reads added to the ring
+         */
+        uint32_t _prepareReads();
+
+        /** Completes the reads the kernel has finished */
+        void _reapCompletions();
+
+        /** Queues a poll on the wake eventfd, completing once a read has been queued or the executor stops */
+        void _armWakePoll();
+
+        /** Wakes the I/O thread from io_uring_enter */
+        void _wakeRingThread();
+
+        /** Opens the file and reads it on the calling thread */
+        static void _readBlocking(ReadRequest &request);
+
+        /**
+         * Fails the request with ECANCELED if its token has been cancelled
+         * @return True if the request was cancelled and has been completed
+         */
+        static bool _completeIfCancelled(ReadRequest &request);
+
+        /** Closes the request's file and completes its result */
+        static void _completeRead(ReadRequest &request);
+
+        IoExecutorDescription _description{};
+
+        Mutex _mutex;
+        Signal _workAvailable;
+        Queue<Work> _blockingWork;
+        Queue<std::unique_ptr<ReadRequest>> _waitingReads;
+        bool _stopping{false};
+
+        std::vector<std::unique_ptr<VenusThread>> _threads;
+
+        /** The io_uring backend, nullptr when reads run on the blocking threads */
+        std::unique_ptr<Ring> _ring;
+    };
+}
+
+#endif //VENUS_IOEXECUTOR_H
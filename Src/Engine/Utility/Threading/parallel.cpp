@@ -0,0 +1,120 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "parallel.h"
+#include "threadPool.h"
+
+namespace Venus::Utility::Threading {
+    uint32_t getParallelLeafCount(uint64_t count, uint64_t grainSize) {
+        uint64_t participants = static_cast<uint64_t>(ThreadPool::instance()->getWorkerQuota()) + 1;
+        uint64_t maximumLeaves = participants * PARALLEL_CHUNKS_PER_THREAD;
+
+        uint64_t grain = std::max<uint64_t>(grainSize, 1);
+        uint64_t leaves = std::min((count + grain - 1) / grain, maximumLeaves);
+
+        return static_cast<uint32_t>(std::max<uint64_t>(leaves, 1));
+    }
+
+    void ParallelRegion::run(uint32_t leafCount, LeafFunction leafFunction, void *context) {
+        if (leafCount <= 1) {
+            for (uint32_t leaf = 0; leaf < leafCount; ++leaf)
+                leafFunction(context, leaf);
+
+            return;
+        }
+
+        // Queued chunks that another thread claimed first still reference the region once run() has returned
+        auto region = std::make_shared<ParallelRegion>(leafCount, leafFunction, context);
+
+        try {
+            region->_runLeaves(0, leafCount);
+        } catch (...) {
+            region->_fail(std::current_exception());
+        }
+
+        // The context lives on the caller's stack, every chunk has to be done with it before an exception unwinds it
+        region->_wait();
+
+        if (region->_exception != nullptr)
+            std::rethrow_exception(region->_exception);
+    }
+
+    ParallelRegion::ParallelRegion(uint32_t leafCount, LeafFunction leafFunction, void *context)
+            : _leafFunction(leafFunction),
+              _context(context),
+              _chunks(std::make_unique<Chunk[]>(leafCount)) {}
+
+    void ParallelRegion::_runLeaves(uint32_t first, uint32_t last) {
+        while (last - first > 1) {
+            if (this->_failed.load(std::memory_order_relaxed))
+                return;
+
+            uint32_t middle = first + (last - first) / 2;
+
+            this->_queueChunk(middle, last);
+            last = middle;
+        }
+
+        if (this->_failed.load(std::memory_order_relaxed))
+            return;
+
+        // Caught here so a leaf throwing on a worker reaches the caller rather than the pool
+        try {
+            this->_leafFunction(this->_context, first);
+        } catch (...) {
+            this->_fail(std::current_exception());
+        }
+    }
+
+    void ParallelRegion::_queueChunk(uint32_t first, uint32_t last) {
+        // Counted before it can be claimed, so the count cannot reach zero while the chunk is outstanding
+        this->_pendingChunks.fetch_add(1, std::memory_order_relaxed);
+
+        uint32_t index = this->_queuedChunks.fetch_add(1, std::memory_order_relaxed);
+        Chunk &chunk = this->_chunks[index];
+
+        chunk.first = first;
+        chunk.last = last;
+        chunk.state.store(ChunkState::Ready, std::memory_order_release);
+
+        ThreadPool::instance()->queueWork([region = this->shared_from_this(), index]() {
+            region->_tryRunChunk(index);
+        });
+    }
+
+    bool ParallelRegion::_tryRunChunk(uint32_t chunk) {
+        auto expected = ChunkState::Ready;
+        if (!this->_chunks[chunk].state.compare_exchange_strong(expected, ChunkState::Claimed,
+                                                                std::memory_order_acquire))
+            return false;
+
+        this->_runLeaves(this->_chunks[chunk].first, this->_chunks[chunk].last);
+
+        if (this->_pendingChunks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            this->_pendingChunks.notify_all();
+
+        return true;
+    }
+
+    void ParallelRegion::_fail(std::exception_ptr exception) {
+        if (!this->_failed.exchange(true, std::memory_order_acq_rel))
+            this->_exception = std::move(exception);
+    }
+
+    void ParallelRegion::_wait() {
+        while (true) {
+            uint32_t pending = this->_pendingChunks.load(std::memory_order_acquire);
+            if (pending == 0)
+                return;
+
+            // Newest chunks are the smallest and least likely to have been picked up by a worker yet
+            bool helped = false;
+            for (uint32_t chunk = this->_queuedChunks.load(std::memory_order_acquire); chunk > 0 && !helped; --chunk)
+                helped = this->_tryRunChunk(chunk - 1);
+
+            if (!helped && !ThreadPool::runPendingWork())
+                this->_pendingChunks.wait(pending, std::memory_order_acquire);
+        }
+    }
+}
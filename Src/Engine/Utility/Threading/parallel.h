@@ -0,0 +1,261 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_PARALLEL_H
+#define VENUS_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Venus::Utility::Threading {
+    /** Number of chunks an automatically sized loop is split into per participating thread */
+    static constexpr uint32_t PARALLEL_CHUNKS_PER_THREAD = 8;
+
+    /** Ranges with fewer elements than this are sorted on the calling thread by parallelSort */
+    static constexpr size_t PARALLEL_SORT_MINIMUM_SIZE = 4096;
+
+    /**
+     * A range of work split into a fixed number of leaves, executed by the calling thread and the ThreadPool.
+     *
+     * Running a range of leaves recursively splits it in half, queuing the upper half on the pool and carrying on with
+     * the lower half, until a single leaf is left to run. Queued halves may be claimed by whichever thread gets to
+     * them first, so the calling thread keeps claiming and running them while it waits rather than blocking. Once every
+     * half has been claimed a calling pool worker helps with other pending work.
+     *
+     * @note Used by parallelFor, parallelReduce and parallelSort, which size the leaves with getParallelLeafCount
+     */
+    class ParallelRegion : public std::enable_shared_from_this<ParallelRegion> {
+    public:
+        /** Runs a single leaf, passed the context given to run() */
+        using LeafFunction = void (*)(void *context, uint32_t leaf);
+
+        /**
+         * Runs every leaf, returning once all of them have completed
+         * @param leafCount The number of leaves
+         * @param leafFunction Function running a single leaf
+         * @param context Context handed to the leaf function
+         * @note Runs the leaves on the calling thread without touching the pool if there is only one
+         * @note If a leaf throws the leaves not yet started are skipped, and the first exception is rethrown once no
+         * thread is running a leaf any more
+         */
+        static void run(uint32_t leafCount, LeafFunction leafFunction, void *context);
+
+        /** Constructor, use run() */
+        ParallelRegion(uint32_t leafCount, LeafFunction leafFunction, void *context);
+
+    private:
+        /** States of a queued half */
+        enum class ChunkState : uint8_t {
+            Empty, Ready, Claimed
+        };
+
+        /** The leaves of a queued half */
+        struct Chunk {
+            uint32_t first{0};
+            uint32_t last{0};
+            std::atomic<ChunkState> state{ChunkState::Empty};
+        };
+
+        /** Runs the leaves from first up to but excluding last, queuing upper halves as it goes */
+        void _runLeaves(uint32_t first, uint32_t last);
+
+        /** Queues the leaves from first up to but excluding last on the pool */
+        void _queueChunk(uint32_t first, uint32_t last);
+
+        /**
+         * Runs the chunk if no other thread has claimed it
+         * @return True if the chunk was claimed by the calling thread
+         */
+        bool _tryRunChunk(uint32_t chunk);
+
+        /** Helps run queued chunks until every chunk has completed */
+        void _wait();
+
+        /** Records the exception if it is the first one thrown, the remaining leaves are skipped */
+        void _fail(std::exception_ptr exception);
+
+        const LeafFunction _leafFunction;
+        void *const _context;
+
+        /** A range of n leaves is split at most n - 1 times, so there is a chunk slot for every leaf */
+        std::unique_ptr<Chunk[]> _chunks;
+        std::atomic_uint32_t _queuedChunks{0};
+        std::atomic_uint32_t _pendingChunks{0};
+
+        /** Set once a leaf has thrown, the exception is written before any thread completes its chunk */
+        std::atomic_bool _failed{false};
+        std::exception_ptr _exception{nullptr};
+    };
+
+    /**
+     * Returns the number of leaves a loop over the given number of elements is split into
+     * @param count The number of elements
+     * @param grainSize The minimum number of elements in a leaf, 0 sizes the leaves automatically
+     * @note The leaf count is capped at PARALLEL_CHUNKS_PER_THREAD leaves for each pool worker and the calling
+     * thread, enough to balance the load without paying the queuing cost for every grain
+     */
+    uint32_t getParallelLeafCount(uint64_t count, uint64_t grainSize);
+
+    /**
+     * Returns the first element of a leaf, leaves differ in size by at most one element
+     * @param count The number of elements
+     * @param leafCount The number of leaves
+     * @param leaf The leaf, may be leafCount to get the end of the last leaf
+     */
+    inline uint64_t getParallelLeafBegin(uint64_t count, uint32_t leafCount, uint32_t leaf) {
+        return count / leafCount * leaf + std::min<uint64_t>(leaf, count % leafCount);
+    }
+
+    /**
+     * Runs the function over every index from begin up to but excluding end, on the calling thread and the ThreadPool
+     * @param begin The first index
+     * @param end The index after the last
+     * @param grainSize The minimum number of indices run together, 0 picks one automatically
+     * @param function Either invoked with each index, or with the begin and end index of each sub range
+     * @note Returns once every index has been run, the calling thread runs part of the range itself
+     * @note If the function throws the indices not yet started are skipped and the first exception is rethrown
+     */
+    template<std::integral Index, typename Function>
+    void parallelFor(Index begin, Index end, uint64_t grainSize, Function &&function) {
+        if (end <= begin)
+            return;
+
+        struct Context {
+            Index begin;
+            uint64_t count;
+            uint32_t leafCount;
+            std::remove_reference_t<Function> *function;
+        };
+
+        auto count = static_cast<uint64_t>(end - begin);
+        Context context{begin, count, getParallelLeafCount(count, grainSize), std::addressof(function)};
+
+        ParallelRegion::run(context.leafCount, [](void *opaque, uint32_t leaf) {
+            auto &context = *static_cast<Context *>(opaque);
+            auto first = static_cast<Index>(
+                    context.begin + getParallelLeafBegin(context.count, context.leafCount, leaf));
+            auto last = static_cast<Index>(
+                    context.begin + getParallelLeafBegin(context.count, context.leafCount, leaf + 1));
+
+            if constexpr (std::is_invocable_v<Function, Index, Index>) {
+                (*context.function)(first, last);
+            } else {
+                for (Index i = first; i < last; ++i)
+                    (*context.function)(i);
+            }
+        }, &context);
+    }
+
+    /** @copydoc parallelFor, sizing the sub ranges automatically */
+    template<std::integral Index, typename Function>
+    void parallelFor(Index begin, Index end, Function &&function) {
+        parallelFor(begin, end, 0, std::forward<Function>(function));
+    }
+
+    /**
+     * Reduces the indices from begin up to but excluding end to a single value, on the calling thread and the
+     * ThreadPool
+     * @param begin The first index
+     * @param end The index after the last
+     * @param identity The value each sub range starts from, returned if the range is empty
+     * @param grainSize The minimum number of indices reduced together, 0 picks one automatically
+     * @param reduceRange Invoked as reduceRange(first, last, value) and returns value with the sub range folded in
+     * @param combine Invoked as combine(lhs, rhs) and returns the two combined
+     * @note Sub range results are combined in index order, so combine only needs to be associative
+     */
+    template<std::integral Index, typename Value, typename ReduceRange, typename Combine>
+    Value parallelReduce(Index begin, Index end, Value identity, uint64_t grainSize, ReduceRange &&reduceRange,
+                         Combine &&combine) {
+        if (end <= begin)
+            return identity;
+
+        struct Context {
+            Index begin;
+            uint64_t count;
+            uint32_t leafCount;
+            const Value *identity;
+            std::remove_reference_t<ReduceRange> *reduceRange;
+            std::vector<Value> partials;
+        };
+
+        auto count = static_cast<uint64_t>(end - begin);
+        auto leafCount = getParallelLeafCount(count, grainSize);
+        Context context{begin, count, leafCount, &identity, std::addressof(reduceRange),
+                        std::vector<Value>(leafCount, identity)};
+
+        ParallelRegion::run(leafCount, [](void *opaque, uint32_t leaf) {
+            auto &context = *static_cast<Context *>(opaque);
+            auto first = static_cast<Index>(
+                    context.begin + getParallelLeafBegin(context.count, context.leafCount, leaf));
+            auto last = static_cast<Index>(
+                    context.begin + getParallelLeafBegin(context.count, context.leafCount, leaf + 1));
+
+            context.partials[leaf] = (*context.reduceRange)(first, last, *context.identity);
+        }, &context);
+
+        Value result = std::move(context.partials[0]);
+        for (uint32_t leaf = 1; leaf < leafCount; ++leaf)
+            result = combine(std::move(result), std::move(context.partials[leaf]));
+
+        return result;
+    }
+
+    /** @copydoc parallelReduce, sizing the sub ranges automatically */
+    template<std::integral Index, typename Value, typename ReduceRange, typename Combine>
+    Value parallelReduce(Index begin, Index end, Value identity, ReduceRange &&reduceRange, Combine &&combine) {
+        return parallelReduce(begin, end, std::move(identity), 0, std::forward<ReduceRange>(reduceRange),
+                              std::forward<Combine>(combine));
+    }
+
+    /**
+     * Sorts the range on the calling thread and the ThreadPool, a parallel merge sort
+     * @param first The first element
+     * @param last The element after the last
+     * @param compare The comparator, as for std::sort
+     * @note Sorts each leaf with std::sort, then merges neighbouring runs in parallel until one run is left. Like
+     * std::sort the sort is not stable.
+     */
+    template<std::random_access_iterator Iterator, typename Compare = std::less<>>
+    void parallelSort(Iterator first, Iterator last, Compare compare = Compare()) {
+        auto count = static_cast<uint64_t>(std::distance(first, last));
+        auto leafCount = getParallelLeafCount(count, PARALLEL_SORT_MINIMUM_SIZE);
+
+        if (leafCount <= 1) {
+            std::sort(first, last, compare);
+            return;
+        }
+
+        auto leafBegin = [&](uint32_t leaf) {
+            return first + static_cast<std::ptrdiff_t>(getParallelLeafBegin(count, leafCount, leaf));
+        };
+
+        parallelFor(0u, leafCount, 1, [&](uint32_t leaf) {
+            std::sort(leafBegin(leaf), leafBegin(leaf + 1), compare);
+        });
+
+        // Each pass merges neighbouring runs of width leaves, doubling the width of a run
+        for (uint32_t width = 1; width < leafCount; width *= 2) {
+            uint32_t merges = (leafCount + 2 * width - 1) / (2 * width);
+
+            parallelFor(0u, merges, 1, [&](uint32_t merge) {
+                uint32_t left = merge * 2 * width;
+                uint32_t middle = std::min(left + width, leafCount);
+                uint32_t right = std::min(left + 2 * width, leafCount);
+
+                if (middle < right)
+                    std::inplace_merge(leafBegin(left), leafBegin(middle), leafBegin(right), compare);
+            });
+        }
+    }
+}
+
+#endif //VENUS_PARALLEL_H
@@ -5,13 +5,30 @@
 #include "pooledThread.h"
 #include "threadPool.h"
 #include "venusThread.h"
-#include <algorithm>
+#include "fiber.h"
+#include "futex.h"
+#include "trace.h"
+#include <chrono>
 
 namespace Venus::Utility::Threading {
-    PooledThread::PooledThread(uint32_t threadId, const std::shared_ptr<ThreadPool> &threadPool, bool tempWorker)
-            : _threadId(threadId),
+    thread_local PooledThread *PooledThread::_currentWorker = nullptr;
+
+    namespace {
+        uint64_t getSteadyNanoseconds() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    }
+
+    PooledThread::PooledThread(uint32_t threadId, const std::shared_ptr<ThreadPool> &threadPool, bool tempWorker,
+                               bool workStealing, WorkerPlacement placement)
+            : _tempWorker(tempWorker),
               _threadPool(threadPool),
-              _tempWorker(tempWorker) {}
+              _owningPool(threadPool.get()),
+              _threadId(threadId),
+              _workStealing(workStealing),
+              _placement(std::move(placement)),
+              _stealSeed(threadId * 2654435761u | 1u) {}
 
     void PooledThread::ignition() {
         _createWorkThread();
@@ -28,6 +45,10 @@ namespace Venus::Utility::Threading {
         policy.Priority = ThreadPriority::High;
 
         _thread = new VenusThread([this] { _run(); }, policy);
+
+        // Not fatal, the thread keeps working wherever the OS runs it
+        auto handle = _thread->native_handle();
+        VenusThread::setAffinity(handle, this->_placement.cpus);
     }
 
     void PooledThread::_registerTaskAsyncWaitHandle(const std::shared_ptr<Task> &taskItem) {
@@ -40,22 +61,16 @@ namespace Venus::Utility::Threading {
         }
     }
 
-    void PooledThread::_sortWorkQueue() {
-        std::sort(this->_workQueue.begin(), this->_workQueue.end(),
-                  [](const auto &lhs, const auto &rhs) -> bool {
-                      return lhs->_priority < rhs->_priority;
-                  });
-    }
-
     std::shared_ptr<AsyncWaitHandle> PooledThread::queueWork(const std::shared_ptr<Task> &taskItem) {
         {
             Lock lock(this->_mutex);
 
             _prepareForExecution();
-            this->_workQueue.push_back(taskItem);
+            this->_workQueue.push(getTaskPriorityLevel(taskItem->_priority), taskItem);
+            Tracer::instant(TraceEventType::TaskQueued, taskItem->_taskName, taskItem->_taskId);
 
             this->_registerTaskAsyncWaitHandle(taskItem);
-            taskItem->_setTaskStatus(TaskStatus::Scheduled);
+            taskItem->_markScheduled();
         }
 
         this->_readyCondition.notify_all();
@@ -80,6 +95,14 @@ namespace Venus::Utility::Threading {
         }
 
         this->_startedCondition.notify_all();
+        PooledThread::_currentWorker = this;
+
+        Tracer::setThreadName(fmt::format("{}{}", WORKER_THREAD_NAME_PREFIX, this->_threadId));
+
+        if (this->_workStealing) {
+            this->_runWorkStealing();
+            return;
+        }
 
         {
             Lock lock(this->_mutex);
@@ -94,37 +117,189 @@ namespace Venus::Utility::Threading {
             {
                 Lock lock(this->_mutex);
 
-                if (this->_workQueue.empty()) {
+                if (this->_workQueue.isEmpty()) {
 
                     this->_workerFinishedCondition.notify_all();
 
                     this->_updateIdleState(true);
+                    this->_beginIdleTime();
                     this->_readyCondition.wait(lock);
+                    this->_endIdleTime();
                     this->_updateIdleState(false);
 
                     continue;
                 }
 
-                task = this->_workQueue.front();
-                this->_workQueue.pop_front();
+                task = this->_workQueue.pop();
             }
 
             this->_currentlyExecuting.store(true, std::memory_order_release);
+            this->_runTask(task);
+            this->_currentlyExecuting.store(false, std::memory_order_release);
+        }
+    }
 
-            PooledThread::_executeTask(task);
-            this->_signalAndRemoveWaitHandle(task->getTaskId());
+    void PooledThread::_runWorkStealing() {
+        {
+            Lock lock(this->_mutex);
+            this->_updateIdleState(false);
+        }
 
+        while (!this->_destroyed) {
+            auto task = this->_takePendingTask();
+
+            if (task == nullptr) {
+                this->_owningPool->_parkWorker(*this);
+                continue;
+            }
+
+            this->_currentlyExecuting.store(true, std::memory_order_release);
+            this->_runTask(task);
             this->_currentlyExecuting.store(false, std::memory_order_release);
         }
+
+        // The pool may have handed this thread a wake as it was being destroyed, pass it on so no work is stranded
+        this->_owningPool->_wakeIdleWorker();
+    }
+
+    std::shared_ptr<Task> PooledThread::_takePendingTask() {
+        if (this->_workStealing) {
+            if (Task *next = this->_workDeque.pop())
+                return std::move(next->_queuedReference);
+
+            return this->_owningPool->_findWork(*this);
+        }
+
+        Lock lock(this->_mutex);
+
+        if (this->_workQueue.isEmpty())
+            return nullptr;
+
+        return this->_workQueue.pop();
+    }
+
+    void PooledThread::_runTask(std::shared_ptr<Task> &task) {
+        // A cancelled task only signals its waiters, not worth a fiber
+        if (task->_runOnFiber && !task->_isCancellationPending()) {
+            // Returns as soon as the task finishes or suspends, a suspended task is completed and signalled by
+            // whichever worker resumes it
+            Fiber::run([this, task]() mutable {
+                this->_executeTask(task);
+                this->_signalTask(task);
+            });
+        } else {
+            this->_executeTask(task);
+            this->_signalTask(task);
+        }
+
+        this->_resumeReadyFibers();
+    }
+
+    void PooledThread::_signalTask(const std::shared_ptr<Task> &task) {
+        if (this->_workStealing)
+            PooledThread::_signalFromWorker(*std::static_pointer_cast<AsyncWaitHandleImpl>(task->getWaitHandle()));
+        else
+            this->_signalAndRemoveWaitHandle(task->getTaskId());
+    }
+
+    void PooledThread::_signalFromWorker(AsyncWaitHandleImpl &waitHandle) {
+        // Not necessarily the thread the task was queued on, a task suspended on a fiber is completed by the worker
+        // that resumed it
+        PooledThread *worker = PooledThread::_currentWorker;
+
+        worker->_signallingTask = true;
+        waitHandle.set();
+        worker->_signallingTask = false;
+    }
+
+    void PooledThread::_resumeReadyFibers() {
+        // Resuming a fiber completes its task, which may hand this thread the next fiber up the chain of waits
+        while (this->_readyFiber != nullptr)
+            Fiber::resume(std::exchange(this->_readyFiber, nullptr));
+    }
+
+    bool PooledThread::_runPendingTask() {
+        auto task = this->_takePendingTask();
+        if (task == nullptr)
+            return false;
+
+        this->_runTask(task);
+        return true;
+    }
+
+    void PooledThread::_waitForWake() {
+        {
+            Lock lock(this->_mutex);
+
+            this->_updateIdleState(true);
+            this->_workerFinishedCondition.notify_all();
+        }
+
+        this->_beginIdleTime();
+
+        // A wake handed out before the thread got to sleep is left in the word, so it is never lost
+        while (this->_wakeWord.exchange(0, std::memory_order_acquire) == 0 && !this->_destroyed)
+            futexWait(this->_wakeWord, 0);
+
+        this->_endIdleTime();
+
+        Lock lock(this->_mutex);
+        this->_updateIdleState(false);
+    }
+
+    void PooledThread::_wake() {
+        this->_wakeWord.store(1, std::memory_order_release);
+        futexWake(this->_wakeWord, 1);
+    }
+
+    void PooledThread::_beginIdleTime() {
+        this->_idleSince.store(getSteadyNanoseconds(), std::memory_order_relaxed);
+    }
+
+    void PooledThread::_endIdleTime() {
+        uint64_t idleSince = this->_idleSince.exchange(0, std::memory_order_relaxed);
+        this->_idleNanoseconds.fetch_add(getSteadyNanoseconds() - idleSince, std::memory_order_relaxed);
+    }
+
+    uint64_t PooledThread::_getIdleNanoseconds() const {
+        uint64_t idleSince = this->_idleSince.load(std::memory_order_relaxed);
+        uint64_t idle = this->_idleNanoseconds.load(std::memory_order_relaxed);
+
+        // Includes the time the thread has been idle for so far if it is idle now
+        if (idleSince != 0)
+            idle += getSteadyNanoseconds() - idleSince;
+
+        return idle;
+    }
+
+    uint32_t PooledThread::_nextStealVictim(uint32_t workerCount) {
+        // xorshift32, only ever touched by this thread
+        this->_stealSeed ^= this->_stealSeed << 13;
+        this->_stealSeed ^= this->_stealSeed >> 17;
+        this->_stealSeed ^= this->_stealSeed << 5;
+
+        return this->_stealSeed % workerCount;
     }
 
     void PooledThread::_executeTask(std::shared_ptr<Task> &task) {
-        task->_setTaskStatus(TaskStatus::InProgress);
-        task->_startedSignal.set();
+        // Cancelled tasks are left in the queues rather than searched for, dropping one here costs nothing more
+        bool started = task->_tryStart();
+
+        // A task waiting for this one to start goes on to wait for it to complete, so is best resumed once it has
+        PooledThread::_signalFromWorker(task->_startedSignal);
 
-        task->_work();
+        if (started) {
+            TraceScope trace(TraceEventType::TaskRun, task->_taskName, task->_taskId);
+            task->_work();
+        } else {
+            Tracer::instant(TraceEventType::TaskCancelled, task->_taskName, task->_taskId);
+        }
 
-        task->_setTaskStatus(TaskStatus::Completed);
+        // Successors whose last dependency this was are ready, handed to the pool before the task is signalled
+        for (const auto &successor : task->_complete()) {
+            if (successor->_releasePredecessor())
+                this->_owningPool->_addScheduledWork(successor);
+        }
     }
 
     void PooledThread::_updateIdleState(bool isIdle) {
@@ -133,15 +308,21 @@ namespace Venus::Utility::Threading {
     }
 
     void PooledThread::_signalAndRemoveWaitHandle(uint32_t taskId) {
-        Lock lock(this->_waitHandleMapMutex);
+        std::shared_ptr<AsyncWaitHandleImpl> waitHandle;
 
-        std::map<uint32_t, std::shared_ptr<AsyncWaitHandleImpl>>::iterator it;
-        it = this->_taskIdToAsyncWaitHandleMap.find(taskId);
+        {
+            Lock lock(this->_waitHandleMapMutex);
 
-        it->second->set();
+            auto it = this->_taskIdToAsyncWaitHandleMap.find(taskId);
+            if (it == this->_taskIdToAsyncWaitHandleMap.end())
+                return;
 
-        if (it != this->_taskIdToAsyncWaitHandleMap.end())
+            waitHandle = std::move(it->second);
             this->_taskIdToAsyncWaitHandleMap.erase(it);
+        }
+
+        // Set outside the lock, setting the handle queues the fibers waiting on it which may land on this thread
+        PooledThread::_signalFromWorker(*waitHandle);
     }
 
     bool PooledThread::isIdle() {
@@ -177,6 +358,7 @@ namespace Venus::Utility::Threading {
         }
 
         this->_readyCondition.notify_all();
+        this->_wake();
         this->_thread->join();
 
         delete this->_thread;
@@ -189,6 +371,9 @@ namespace Venus::Utility::Threading {
     }
 
     uint32_t PooledThread::workSize() {
+        if (this->_workStealing)
+            return this->_workDeque.size();
+
         Lock lock(this->_mutex);
 
         return this->_workQueue.size();
@@ -213,35 +398,4 @@ namespace Venus::Utility::Threading {
     bool PooledThread::isDestroyed() const {
         return this->_destroyed;
     }
-
-    void PooledThread::stealWork(const std::shared_ptr<PooledThread> &victim) {
-        Lock myLock(this->_mutex);
-        Lock victimsLock(victim->_mutex);
-
-        this->_mergeWithQueue(victim->_workQueue);
-        PooledThread::_makeQueueEmpty(victim->_workQueue);
-    }
-
-    void PooledThread::_mergeWithQueue(DeQueue<std::shared_ptr<Task>> queue) {
-        DeQueue<std::shared_ptr<Task>> newQueue{};
-
-        while (!this->_workQueue.empty() || !queue.empty()) {
-            if (!this->_workQueue.empty()) {
-                newQueue.push_back(this->_workQueue.front());
-                this->_workQueue.pop_front();
-            }
-            if (!queue.empty()) {
-                newQueue.push_back(queue.front());
-                queue.pop_front();
-            }
-        }
-
-        this->_workQueue.swap(newQueue);
-    }
-
-    void PooledThread::_makeQueueEmpty(DeQueue<std::shared_ptr<Task>> &queue) {
-        DeQueue<std::shared_ptr<Task>> empty;
-        queue.swap(empty);
-    }
 }
-
@@ -9,15 +9,33 @@
 #include <memory>
 #include <thread>
 #include <utility>
+#include <vector>
 #include <iostream>
 #include "TaskScheduler/task.h"
 #include "threading.h"
+#include <Datastructures/chaseLevDeque.h>
+#include <Datastructures/priorityBucketQueue.h>
 
 namespace Venus::Utility::Threading {
     class ThreadPool;
 
+    class Fiber;
+
+    /** Where a pooled thread runs */
+    struct WorkerPlacement {
+        /** The logical CPUs the thread is pinned to, empty if it is free to run anywhere */
+        std::vector<uint32_t> cpus;
+
+        /** The domain of the CPUs, 0 if the thread is not pinned */
+        uint32_t domain{0};
+    };
+
     /**
      * Represents a single pooled thread
+     *
+     * @note When work stealing is enabled the thread owns a Chase-Lev deque instead of a sorted work queue. Work
+     * queued from the thread itself is pushed onto its deque, once the deque is empty the thread takes work from the
+     * pool's injection queue and then steals half of the deque of a randomly chosen worker.
      */
     class PooledThread : public std::enable_shared_from_this<PooledThread> {
     public:
@@ -28,16 +46,19 @@ namespace Venus::Utility::Threading {
          * @param threadId The read identifier
          * @param threadPool The parent thread pool
          * @param tempWorker Boolean indicating if the thread has been added because another worker is sleeping
+         * @param workStealing Boolean indicating if the thread takes its work from a work stealing deque
+         * @param placement Where the thread runs
          */
         explicit PooledThread(uint32_t threadId, const std::shared_ptr<ThreadPool> &threadPool,
-                              bool tempWorker = false);
+                              bool tempWorker = false, bool workStealing = false, WorkerPlacement placement = {});
 
         /** Ignites the thread*/
         void ignition();
 
         /**
          * Queues a task to be executed by the thread
-         * @note Should call _sortWorkQueue() to ensure task is positioned correctly
+         * @note Tasks are executed highest priority first, tasks of equal priority in the order they were queued
+         * @note Only used when work stealing is disabled, stealing workers are handed work by the pool
          * @param taskItem The task to be queued
          */
         std::shared_ptr<AsyncWaitHandle> queueWork(const std::shared_ptr<Task> &taskItem);
@@ -78,12 +99,6 @@ namespace Venus::Utility::Threading {
         /** Returns the next work identifier */
         uint32_t getNextWorkId();
 
-        /**
-         * The calling thread steals all the work from the victim worker
-         * @param victim The victim losing the work
-         */
-        void stealWork(const std::shared_ptr<PooledThread> &victim);
-
         /** Returns a boolean indicating if this worker has been destroyed*/
         bool isDestroyed() const;
 
@@ -99,19 +114,71 @@ namespace Venus::Utility::Threading {
          */
         void _registerTaskAsyncWaitHandle(const std::shared_ptr<Task> &taskItem);
 
+        /** Primary worker method that is ran when the thread is first initialized.*/
+        void _run();
+
+        /** Worker loop used when work stealing is enabled */
+        void _runWorkStealing();
+
         /**
-         * Sorts the work queue to bring high priority task to the front
+         * Takes the next task this thread should run, from its own queue or, when work stealing, from the rest of the
+         * pool
+         * @return The task, nullptr if there is no work
          */
-        void _sortWorkQueue();
+        std::shared_ptr<Task> _takePendingTask();
 
-        /** Primary worker method that is ran when the thread is first initialized.*/
-        void _run();
+        /**
+         * Executes the task and signals its wait handle
+         * @note Tasks scheduled by a fiber backed TaskScheduler are started on a fiber, the call returns once the task
+         * has finished or suspended
+         */
+        void _runTask(std::shared_ptr<Task> &task);
+
+        /** Signals the task's wait handle, registered with this thread when work stealing is disabled */
+        void _signalTask(const std::shared_ptr<Task> &task);
 
         /**
-         * Executes the given task
+         * Sets a wait handle of the task the calling worker is running, handing the worker the first fiber suspended
+         * on the handle
+         */
+        static void _signalFromWorker(AsyncWaitHandleImpl &waitHandle);
+
+        /** Resumes the fibers handed to this thread by the tasks it ran, until none is left */
+        void _resumeReadyFibers();
+
+        /**
+         * Runs a single pending task on behalf of a task that is waiting on this thread
+         * @return False if there was no work
+         */
+        bool _runPendingTask();
+
+        /**
+         * Blocks the thread on a futex until it is handed a wake by the pool or destroyed
+         * @note Marks the thread as idle while it is blocked
+         */
+        void _waitForWake();
+
+        /** Wakes the thread from _waitForWake() */
+        void _wake();
+
+        /** Starts counting the time the thread spends idle */
+        void _beginIdleTime();
+
+        /** Stops counting the time the thread spends idle */
+        void _endIdleTime();
+
+        /** Returns the total time the thread has spent idle, including the time it has been idle for so far */
+        uint64_t _getIdleNanoseconds() const;
+
+        /** Returns the index of the next worker to try and steal from, out of the given worker count */
+        uint32_t _nextStealVictim(uint32_t workerCount);
+
+        /**
+         * Executes the given task, skipping its work if it has been cancelled. Successors it releases are queued on
+         * the pool owning this worker.
          * @param task The task to be executed
          */
-        static void _executeTask(std::shared_ptr<Task> &task);
+        void _executeTask(std::shared_ptr<Task> &task);
 
         /** Signals that the given tasks has completed */
         void _signalAndRemoveWaitHandle(uint32_t taskId);
@@ -123,36 +190,25 @@ namespace Venus::Utility::Threading {
          */
         void _updateIdleState(bool isIdle);
 
-        /**
-         * Merges this instance's queue with the parameter queue
-         * @param queue Queue to merge from
-         */
-        void _mergeWithQueue(DeQueue<std::shared_ptr<Task>> queue);
-
-        /**
-         * Makes the queue in the parameter empty
-         * @param queue The queue to be made empty
-         */
-        static void _makeQueueEmpty(DeQueue<std::shared_ptr<Task>> &queue);
-
         /** Creates and initialises the current worker thread*/
         void _createWorkThread();
 
         /** Prepares the pooled for execution by updating execution states*/
         void _prepareForExecution();
 
-        DeQueue<std::shared_ptr<Task>> _workQueue{};
+        DataStructures::PriorityBucketQueue<std::shared_ptr<Task>, TASK_PRIORITY_LEVELS> _workQueue{};
         Mutex _waitHandleMapMutex;
         Map<uint32_t, std::shared_ptr<AsyncWaitHandleImpl >> _taskIdToAsyncWaitHandleMap;
 
         bool _idle{true};
         bool _threadStarted{false};
         bool _threadReady{false};
-        bool _destroyed{false};
+        std::atomic_bool _destroyed{false};
         std::atomic_bool _currentlyExecuting{false};
         const bool _tempWorker{false};
 
         const std::weak_ptr<ThreadPool> _threadPool{};
+        ThreadPool *const _owningPool{nullptr};
         std::thread *_thread{nullptr};
         const uint32_t _threadId{0};
         time_t _idleTime = 0;
@@ -163,6 +219,25 @@ namespace Venus::Utility::Threading {
         std::atomic_int32_t _workId{0};
 
         Mutex _mutex;
+
+        /** Work stealing state, unused when work stealing is disabled */
+        const bool _workStealing{false};
+        DataStructures::ChaseLevDeque<Task> _workDeque;
+        const WorkerPlacement _placement;
+        std::atomic_uint32_t _wakeWord{0};
+        uint32_t _stealSeed{0};
+
+        /** Idle time sampled by the pool's elastic controller, which alone touches _sampledIdleNanoseconds */
+        std::atomic_uint64_t _idleNanoseconds{0};
+        std::atomic_uint64_t _idleSince{0};
+        uint64_t _sampledIdleNanoseconds{0};
+
+        /** Set while this thread signals a task it runs, a fiber waiting on the task is resumed here next */
+        bool _signallingTask{false};
+        Fiber *_readyFiber{nullptr};
+
+        /** The pooled thread running on the calling thread, nullptr if it is not a pool worker */
+        static thread_local PooledThread *_currentWorker;
     };
 }
 
@@ -3,6 +3,11 @@
 //
 
 #include "threadPool.h"
+#include "asyncWaitHandleImpl.h"
+#include "venusThread.h"
+#include "trace.h"
+#include <algorithm>
+#include <array>
 
 
 namespace Venus::Utility::Threading {
@@ -11,29 +16,69 @@ namespace Venus::Utility::Threading {
     static constexpr int TEMP_WORKER_CHECK_PERIOD = 32;
 
     ThreadPool::ThreadPool(ThreadPoolDescription description) :
-            _quota(description.absoluteMaximum),
             _enableWorkStealing(description.enableWorkStealing),
             _tempPooledThreads(this->_pooledThreads) {
+        const auto &topology = CpuTopology::get();
+
+        if (description.absoluteMaximum == 0)
+            description.absoluteMaximum = topology.getLogicalCpuCount();
+
+        if (description.affinity != WorkerAffinity::None)
+            this->_domains = topology.getDomains(description.domainKind);
+
+        if (description.elasticMaximum == 0)
+            description.elasticMaximum = description.absoluteMaximum;
+
+        this->_quota = description.absoluteMaximum;
         this->_description = description;
+
+        if (description.enableElasticScaling) {
+            // Scheduled like the workers, so a saturated pool cannot starve the thread deciding to grow it
+            auto policy = VenusSchedulingPolicy();
+            policy.Policy = SCHED_RR;
+            policy.Priority = ThreadPriority::High;
+
+            this->_elasticController = new VenusThread([this] { this->_runElasticController(); }, policy);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        this->_stopElasticController();
     }
 
-    std::shared_ptr<PooledWorkDescription> ThreadPool::queueWork(const std::function<void()> &workMethod) {
+    std::shared_ptr<PooledWorkDescription>
+    ThreadPool::queueWork(const std::function<void()> &workMethod, const CancellationToken &cancellation) {
+        if (this->_enableWorkStealing) {
+            _doTempWorkerCleanup();
+
+            auto task = ThreadPool::_createTaskFromWorkMethod(workMethod, ++this->_workIds, cancellation);
+            this->_submitStealableWork(task);
+
+            return std::make_shared<PooledWorkDescription>(task->getWaitHandle(), task->getTaskId(), task);
+        }
+
         auto worker = _getOrCreateLeastBusyWorker();
 
-        auto task = ThreadPool::_createTaskFromWorkMethod(workMethod, worker->getNextWorkId());
+        auto task = ThreadPool::_createTaskFromWorkMethod(workMethod, worker->getNextWorkId(), cancellation);
         worker->queueWork(task);
 
-        auto workDesc = std::make_shared<PooledWorkDescription>(task->getWaitHandle(), task->getTaskId());
+        auto workDesc = std::make_shared<PooledWorkDescription>(task->getWaitHandle(), task->getTaskId(), task);
         return workDesc;
     }
 
+    Executor::ScheduleAwaitable ThreadPool::schedule() {
+        return ThreadPoolExecutor::instance().schedule();
+    }
+
     std::shared_ptr<Task>
-    ThreadPool::_createTaskFromWorkMethod(const std::function<void()> &workMethod, uint32_t workId) {
+    ThreadPool::_createTaskFromWorkMethod(const std::function<void()> &workMethod, uint32_t workId,
+                                          const CancellationToken &cancellation) {
         auto taskDesc = TaskDescription();
         taskDesc.TaskName = fmt::format("POOLEDTASK::{}", workId);
         taskDesc.TaskId = workId;
         taskDesc.Work = workMethod;
         taskDesc.Priority = TaskPriority::DefaultPool;
+        taskDesc.Cancellation = cancellation;
 
         return std::make_shared<Task>(taskDesc);
     }
@@ -102,9 +147,15 @@ namespace Venus::Utility::Threading {
         } else {
             _tempPooledThreads.push_back(worker);
         }
+
+        ++this->_workerCount;
     }
 
     void ThreadPool::_doTempWorkerCleanup() {
+        // The elastic controller retires temporary workers on its own schedule
+        if (this->_description.enableElasticScaling)
+            return;
+
         uint32_t age = ++_workerAge;
 
         if (age > TEMP_WORKER_CHECK_PERIOD) {
@@ -117,8 +168,14 @@ namespace Venus::Utility::Threading {
         Lock lock(this->_mutex);
 
         for (const auto &worker : this->_tempPooledThreads) {
-            if (!worker->hasWork())
-                worker->destroy();
+            if (worker->hasWork())
+                continue;
+
+            // A stealing worker that is not listed as idle is about to run work, destroying it would strand its wake
+            if (this->_enableWorkStealing && !this->_removeIdleWorker(worker.get()))
+                continue;
+
+            worker->destroy();
         }
 
         this->_removeTempWorkerIfDestroyed();
@@ -132,6 +189,11 @@ namespace Venus::Utility::Threading {
         _tempPooledThreads.erase(
                 std::remove_if(_tempPooledThreads.begin(), _tempPooledThreads.end(), removeIfDestroyed),
                 _tempPooledThreads.end());
+
+        this->_workerCount = this->_getWorkerCount();
+
+        if (this->_enableWorkStealing)
+            this->_publishStealVictims();
     }
 
     void ThreadPool::addWorker() {
@@ -149,46 +211,40 @@ namespace Venus::Utility::Threading {
             this->_removeOneWorker();
     }
 
-    void ThreadPool::_removeOneWorker() {
-        Lock lock(this->_mutex);
-        if (!this->_enableWorkStealing || this->_tempPooledThreads.empty())
-            return;
-
-        auto leastBusy = this->_getLeastBusyWorkerFromExistingPools();
-        auto workId = leastBusy->getNextWorkId();
+    bool ThreadPool::runPendingWork() {
+        PooledThread *worker = PooledThread::_currentWorker;
 
-        auto task = this->_createTaskFromWorkMethod([this]() {
-            auto workerId = this->_leastBusyStealWork();
-            this->_removeTempWorkerById(workerId);
-        }, workId);
-        task->_setPriority(TaskPriority::VeryHigh); // We want this to be executed immediately
+        return worker != nullptr && worker->_runPendingTask();
+    }
 
-        ThreadPool::_queueTaskAndSort(leastBusy, task);
+    bool ThreadPool::isWorkerThread() {
+        return PooledThread::_currentWorker != nullptr;
     }
 
-    uint32_t ThreadPool::_leastBusyStealWork() {
-        Lock(this->_mutex);
+    bool ThreadPool::resumeAfterCurrentTask(Fiber *fiber) {
+        PooledThread *worker = PooledThread::_currentWorker;
 
-        auto leastBusyWorker = _getLeastBusyWorkerFromExistingPools();
-        auto tempWorker = _tempPooledThreads.front();
+        if (worker == nullptr || !worker->_signallingTask || worker->_readyFiber != nullptr)
+            return false;
 
-        leastBusyWorker->stealWork(tempWorker);
+        worker->_readyFiber = fiber;
+        return true;
+    }
 
-        return tempWorker->getId();
+    uint32_t ThreadPool::getWorkerQuota() const {
+        return this->_quota.load(std::memory_order_relaxed);
     }
 
-    void ThreadPool::_removeTempWorkerById(uint32_t workerId) {
-        for (const auto &worker : this->_tempPooledThreads) {
-            if (worker->getId() == workerId) {
-                worker->destroy();
-                break;
-            }
-        }
+    void ThreadPool::_removeOneWorker() {
+        if (!this->_enableWorkStealing)
+            return;
 
-        this->_removeTempWorkerIfDestroyed();
+        this->_removeLeastBusyTempWorker();
     }
 
     void ThreadPool::shutdown() {
+        this->_stopElasticController();
+
         for (const auto &worker : this->_pooledThreads) {
             worker->kill();
         }
@@ -196,25 +252,391 @@ namespace Venus::Utility::Threading {
         for (const auto &tempWorker : this->_tempPooledThreads) {
             tempWorker->kill();
         }
+
+        if (this->_enableWorkStealing)
+            this->_releaseQueuedWork();
     }
 
     std::shared_ptr<PooledThread> ThreadPool::_createNewWorker() {
-        bool isTemp = this->_getWorkerCount() >= this->_description.absoluteMaximum;
+        uint32_t workerIndex = this->_getWorkerCount();
+        bool isTemp = workerIndex >= this->_description.absoluteMaximum;
 
-        auto worker = std::make_shared<PooledThread>(++this->_threadIds, this->shared_from_this(), isTemp);
+        auto worker = std::make_shared<PooledThread>(++this->_threadIds, this->shared_from_this(), isTemp,
+                                                     this->_enableWorkStealing,
+                                                     this->_getWorkerPlacement(workerIndex));
         worker->ignition();
 
         return worker;
     }
 
     void ThreadPool::_addScheduledWork(const std::shared_ptr<Task> &task) {
+        if (this->_enableWorkStealing) {
+            task->setTaskId(++this->_workIds);
+            this->_submitStealableWork(task);
+            return;
+        }
+
         auto worker = this->_getOrCreateLeastBusyWorker();
         task->setTaskId(worker->getNextWorkId());
-        ThreadPool::_queueTaskAndSort(worker, task);
+        worker->queueWork(task);
     }
 
-    void ThreadPool::_queueTaskAndSort(const std::shared_ptr<PooledThread> &worker, const std::shared_ptr<Task> &task) {
-        worker->queueWork(task);
-        worker->_sortWorkQueue();
+    void ThreadPool::_submitStealableWork(const std::shared_ptr<Task> &task) {
+        task->_setAsyncWaitHandle(std::make_shared<AsyncWaitHandleImpl>());
+        task->_markScheduled();
+        Tracer::instant(TraceEventType::TaskQueued, task->_taskName, task->_taskId);
+
+        PooledThread *worker = PooledThread::_currentWorker;
+
+        if (worker != nullptr && worker->_owningPool == this) {
+            task->_queuedReference = task;
+            worker->_workDeque.push(task.get());
+        } else {
+            Lock lock(this->_injectionMutex);
+
+            this->_injectionQueue.push(getTaskPriorityLevel(task->_priority), task);
+            ++this->_injectedWork;
+        }
+
+        this->_ensureStealingWorker();
+        this->_wakeIdleWorker();
+    }
+
+    void ThreadPool::_releaseQueuedWork() {
+        for (const auto *workers : {&this->_pooledThreads, &this->_tempPooledThreads}) {
+            for (const auto &worker : *workers) {
+                // The owner has exited, stealing is the safe way to empty the deque from another thread
+                while (Task *task = worker->_workDeque.steal())
+                    task->_queuedReference.reset();
+            }
+        }
+
+        Lock lock(this->_injectionMutex);
+
+        while (!this->_injectionQueue.isEmpty())
+            this->_injectionQueue.pop();
+
+        this->_injectedWork = 0;
+    }
+
+    void ThreadPool::_ensureStealingWorker() {
+        if (this->_workerCount.load(std::memory_order_relaxed) >= this->_quota.load(std::memory_order_relaxed))
+            return;
+
+        Lock lock(this->_mutex);
+        if (this->_getWorkerCount() >= this->_quota)
+            return;
+
+        auto worker = this->_createNewWorker();
+        this->_insertWorkerToPool(worker);
+        this->_publishStealVictims();
+    }
+
+    std::shared_ptr<Task> ThreadPool::_findWork(PooledThread &worker) {
+        ++this->_searchingWorkers;
+
+        auto task = this->_takeInjectedWork(worker);
+        if (task == nullptr)
+            task = this->_stealWork(worker);
+
+        // While a worker is searching nobody else is woken, so the last one to stop searching wakes another to pick
+        // up whatever work remains
+        if (--this->_searchingWorkers == 0 && task != nullptr)
+            this->_wakeIdleWorker();
+
+        return task;
+    }
+
+    std::shared_ptr<Task> ThreadPool::_takeInjectedWork(PooledThread &worker) {
+        if (this->_injectedWork.load(std::memory_order_relaxed) == 0)
+            return nullptr;
+
+        Lock lock(this->_injectionMutex);
+
+        if (this->_injectionQueue.isEmpty())
+            return nullptr;
+
+        auto task = this->_injectionQueue.pop();
+
+        // Share the backlog out between the workers rather than letting the first one to wake take all of it
+        uint32_t workers = std::max(this->_workerCount.load(std::memory_order_relaxed), 1u);
+        uint32_t batch = std::min(static_cast<uint32_t>(this->_injectionQueue.size()) / workers,
+                                  WORK_STEALING_INJECTION_BATCH);
+
+        std::array<Task *, WORK_STEALING_INJECTION_BATCH> queued{};
+        for (uint32_t i = 0; i < batch; ++i) {
+            queued[i] = this->_injectionQueue.front().get();
+            queued[i]->_queuedReference = this->_injectionQueue.pop();
+        }
+
+        // The worker pops its deque newest first, push in reverse so it still runs the batch in priority order
+        for (uint32_t i = batch; i > 0; --i)
+            worker._workDeque.push(queued[i - 1]);
+
+        this->_injectedWork -= batch + 1;
+        return task;
+    }
+
+    std::shared_ptr<Task> ThreadPool::_stealWork(PooledThread &thief) {
+        auto victims = this->_stealVictims.load(std::memory_order_acquire);
+        if (victims == nullptr || victims->size() < 2)
+            return nullptr;
+
+        auto workerCount = static_cast<uint32_t>(victims->size());
+        uint32_t start = thief._nextStealVictim(workerCount);
+
+        // Stealing from the thief's own domain first keeps the work near the memory and cache it was queued from
+        bool preferDomain = this->_domains.size() > 1;
+        uint32_t attempts = preferDomain ? workerCount * 2 : workerCount;
+
+        for (uint32_t i = 0; i < attempts; ++i) {
+            PooledThread *victim = (*victims)[(start + i) % workerCount].get();
+            if (victim == &thief)
+                continue;
+
+            bool sameDomain = victim->_placement.domain == thief._placement.domain;
+            if (preferDomain && sameDomain != (i < workerCount))
+                continue;
+
+            uint32_t available = victim->_workDeque.size();
+            if (available == 0)
+                continue;
+
+            Task *stolen = victim->_workDeque.steal();
+            if (stolen == nullptr)
+                continue;
+
+            for (uint32_t taken = 1; taken < (available + 1) / 2; ++taken) {
+                Task *extra = victim->_workDeque.steal();
+                if (extra == nullptr)
+                    break;
+
+                thief._workDeque.push(extra);
+            }
+
+            Tracer::instant(TraceEventType::TaskStolen, stolen->_taskName, victim->_threadId);
+            return std::move(stolen->_queuedReference);
+        }
+
+        return nullptr;
+    }
+
+    bool ThreadPool::_hasStealableWork() {
+        if (this->_injectedWork.load() > 0)
+            return true;
+
+        auto victims = this->_stealVictims.load(std::memory_order_acquire);
+        if (victims == nullptr)
+            return false;
+
+        return std::any_of(victims->begin(), victims->end(), [](const std::shared_ptr<PooledThread> &worker) {
+            return !worker->_workDeque.isEmpty();
+        });
+    }
+
+    void ThreadPool::_parkWorker(PooledThread &worker) {
+        {
+            Lock lock(this->_idleMutex);
+
+            this->_idleWorkers.push_back(&worker);
+            ++this->_idleWorkerCount;
+        }
+
+        // Pairs with the fence in _wakeIdleWorker, either the submitter sees this worker listed or we see its work
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (this->_hasStealableWork() && this->_removeIdleWorker(&worker))
+            return;
+
+        worker._waitForWake();
+    }
+
+    void ThreadPool::_wakeIdleWorker() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // A searching worker is bound to find the work, see _findWork
+        if (this->_searchingWorkers.load(std::memory_order_relaxed) > 0 ||
+            this->_idleWorkerCount.load(std::memory_order_relaxed) == 0)
+            return;
+
+        PooledThread *worker;
+
+        {
+            Lock lock(this->_idleMutex);
+
+            if (this->_idleWorkers.empty())
+                return;
+
+            worker = this->_idleWorkers.back();
+            this->_idleWorkers.pop_back();
+            --this->_idleWorkerCount;
+        }
+
+        worker->_wake();
+    }
+
+    bool ThreadPool::_removeIdleWorker(PooledThread *worker) {
+        Lock lock(this->_idleMutex);
+
+        auto it = std::find(this->_idleWorkers.begin(), this->_idleWorkers.end(), worker);
+        if (it == this->_idleWorkers.end())
+            return false;
+
+        this->_idleWorkers.erase(it);
+        --this->_idleWorkerCount;
+
+        return true;
+    }
+
+    void ThreadPool::_publishStealVictims() {
+        auto victims = std::make_shared<std::vector<std::shared_ptr<PooledThread>>>(this->_pooledThreads);
+        victims->insert(victims->end(), this->_tempPooledThreads.begin(), this->_tempPooledThreads.end());
+
+        this->_stealVictims.store(std::move(victims), std::memory_order_release);
+    }
+
+    WorkerPlacement ThreadPool::_getWorkerPlacement(uint32_t workerIndex) const {
+        WorkerPlacement placement;
+        if (this->_domains.empty())
+            return placement;
+
+        auto domainCount = static_cast<uint32_t>(this->_domains.size());
+        placement.domain = workerIndex % domainCount;
+
+        const auto &cpus = this->_domains[placement.domain];
+        if (this->_description.affinity == WorkerAffinity::Core)
+            placement.cpus.push_back(cpus[(workerIndex / domainCount) % cpus.size()]);
+        else
+            placement.cpus = cpus;
+
+        return placement;
+    }
+
+    void ThreadPool::_runElasticController() {
+        Lock lock(this->_elasticMutex);
+        this->_lastElasticSample = std::chrono::steady_clock::now();
+
+        while (!this->_stopElastic) {
+            this->_elasticSignal.wait_for(lock, this->_description.elasticSampleInterval);
+            if (this->_stopElastic)
+                break;
+
+            lock.unlock();
+            this->_sampleElasticLoad();
+            lock.lock();
+        }
+    }
+
+    void ThreadPool::_sampleElasticLoad() {
+        std::vector<std::shared_ptr<PooledThread>> workers;
+
+        {
+            Lock lock(this->_mutex);
+
+            workers = this->_pooledThreads;
+            workers.insert(workers.end(), this->_tempPooledThreads.begin(), this->_tempPooledThreads.end());
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - this->_lastElasticSample).count());
+        this->_lastElasticSample = now;
+
+        if (workers.empty() || elapsed == 0)
+            return;
+
+        double busy = 0;
+        uint64_t queued = this->_injectedWork.load(std::memory_order_relaxed);
+
+        for (const auto &worker : workers) {
+            uint64_t idle = worker->_getIdleNanoseconds();
+            uint64_t idleSinceSample = std::min(idle - worker->_sampledIdleNanoseconds, elapsed);
+            worker->_sampledIdleNanoseconds = idle;
+
+            busy += 1.0 - static_cast<double>(idleSinceSample) / static_cast<double>(elapsed);
+            queued += worker->workSize();
+        }
+
+        double utilisation = busy / static_cast<double>(workers.size());
+
+        // Work waiting while every worker is busy means workers are blocked or there are too few of them
+        if (utilisation >= ELASTIC_GROW_UTILISATION && queued > 0) {
+            ++this->_growSamples;
+            this->_shrinkSamples = 0;
+        } else if (utilisation <= ELASTIC_SHRINK_UTILISATION) {
+            ++this->_shrinkSamples;
+            this->_growSamples = 0;
+        } else {
+            this->_growSamples = 0;
+            this->_shrinkSamples = 0;
+        }
+
+        if (this->_growSamples >= ELASTIC_GROW_SAMPLES) {
+            this->_growSamples = 0;
+
+            if (this->_elasticWorkers < this->_description.elasticMaximum)
+                this->_growElastic();
+        }
+
+        // Once the pool has been quiet for long enough a worker is retired every sample until the load picks up
+        if (this->_shrinkSamples >= ELASTIC_SHRINK_SAMPLES) {
+            if (this->_elasticWorkers > 0)
+                this->_shrinkElastic();
+            else if (workers.size() > this->_quota.load(std::memory_order_relaxed))
+                this->_removeLeastBusyTempWorker();
+        }
+    }
+
+    void ThreadPool::_growElastic() {
+        ++this->_elasticWorkers;
+        ++this->_quota;
+
+        // A stealing pool only creates workers as work is submitted, the queued work may already be all there is
+        if (this->_enableWorkStealing)
+            this->_ensureStealingWorker();
+    }
+
+    bool ThreadPool::_shrinkElastic() {
+        Lock lock(this->_mutex);
+
+        // The worker added to the quota was never created
+        if (this->_getWorkerCount() < this->_quota) {
+            --this->_elasticWorkers;
+            --this->_quota;
+            return true;
+        }
+
+        for (const auto &worker : this->_tempPooledThreads) {
+            if (worker->hasWork())
+                continue;
+
+            if (this->_enableWorkStealing && !this->_removeIdleWorker(worker.get()))
+                continue;
+
+            worker->destroy();
+            this->_removeTempWorkerIfDestroyed();
+
+            --this->_elasticWorkers;
+            --this->_quota;
+            return true;
+        }
+
+        return false;
+    }
+
+    void ThreadPool::_stopElasticController() {
+        if (this->_elasticController == nullptr)
+            return;
+
+        {
+            Lock lock(this->_elasticMutex);
+            this->_stopElastic = true;
+        }
+
+        this->_elasticSignal.notify_all();
+        this->_elasticController->join();
+
+        delete this->_elasticController;
+        this->_elasticController = nullptr;
     }
-}
\ No newline at end of file
+}
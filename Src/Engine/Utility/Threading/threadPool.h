@@ -8,27 +8,82 @@
 #include <cstdint>
 #include <vector>
 #include <thread>
+#include <chrono>
 #include "Module.h"
 #include <Datastructures/fibonacciHeap.h>
 #include <map>
 #include "pooledThread.h"
+#include "executor.h"
+#include "cpuTopology.h"
 
 namespace Venus::Utility::Threading {
 
     class TaskScheduler;
 
+    /** Where the workers of a thread pool are allowed to run */
+    enum class WorkerAffinity : uint8_t {
+        /** Workers run wherever the OS schedules them */
+        None,
+        /** Each worker is pinned to a single logical CPU, spread over the domains */
+        Core,
+        /** Each worker is pinned to the CPUs of one domain, spread over the domains */
+        Domain
+    };
+
     /**
      * Contains a description for a thread pool
      */
     struct ThreadPoolDescription {
     public:
-        /** The maximum number of hardware threads supported by the system */
+        /**
+         * The number of permanent workers, 0 to run one per logical CPU the process may use
+         * @note Read from the CpuTopology, so it respects the CPUs that are online and the process' affinity mask
+         */
         uint32_t absoluteMaximum{0};
 
-        /** Boolean indicating if thread are allowed to steal work */
+        /**
+         * Boolean indicating if thread are allowed to steal work
+         * @note When enabled each worker owns a lock-free deque and idle workers steal from each other, otherwise
+         * work is handed to the least busy worker's priority sorted queue.
+         */
         bool enableWorkStealing{true};
+
+        /**
+         * Where the workers run
+         * @note Pinned stealing workers steal from workers in their own domain before any other
+         */
+        WorkerAffinity affinity{WorkerAffinity::None};
+
+        /** What the CPUs of a domain share, used when the workers are pinned */
+        CpuDomainKind domainKind{CpuDomainKind::NumaNode};
+
+        /**
+         * Boolean indicating if a controller thread grows and shrinks the temporary workers with the measured load
+         * @note The controller takes over from the temporary worker clean up done every TEMP_WORKER_CHECK_PERIOD
+         * queued work items, so a quiet pool also shrinks
+         */
+        bool enableElasticScaling{false};
+
+        /** The most temporary workers the controller adds, 0 to allow as many as there are permanent workers */
+        uint32_t elasticMaximum{0};
+
+        /** How often the controller samples the workers */
+        std::chrono::milliseconds elasticSampleInterval{10};
     };
 
+    /** Utilisation of the workers at or above which the elastic controller considers growing the pool */
+    static constexpr double ELASTIC_GROW_UTILISATION = 0.9;
+
+    /** Utilisation of the workers at or below which the elastic controller considers shrinking the pool */
+    static constexpr double ELASTIC_SHRINK_UTILISATION = 0.5;
+
+    /**
+     * Consecutive samples the load has to stay past a threshold before the pool grows or shrinks, growing is quick
+     * so blocked workers are covered, shrinking is slow so a burst does not churn threads
+     */
+    static constexpr uint32_t ELASTIC_GROW_SAMPLES = 3;
+    static constexpr uint32_t ELASTIC_SHRINK_SAMPLES = 100;
+
     /**
      * Represents a description of a pooled work
      */
@@ -39,9 +94,11 @@ namespace Venus::Utility::Threading {
          * @param waitHandle Waithandle Ptr
          * @param workId Work Id
          */
-        PooledWorkDescription(std::shared_ptr<AsyncWaitHandle> waitHandle, uint32_t workId)
+        PooledWorkDescription(std::shared_ptr<AsyncWaitHandle> waitHandle, uint32_t workId,
+                              std::weak_ptr<Task> task = {})
                 : WaitHandle(std::move(waitHandle)),
-                  WorkId(workId) {}
+                  WorkId(workId),
+                  _task(std::move(task)) {}
 
         /**
          * Waits for the pooled work item to be completed
@@ -51,17 +108,35 @@ namespace Venus::Utility::Threading {
             this->WaitHandle->wait();
         }
 
+        /**
+         * Cancels the work if it has not started, the worker reaching it skips it and sets the wait handle
+         * @return False if the work has already started
+         */
+        bool cancel() {
+            auto task = this->_task.lock();
+            return task != nullptr && task->cancel();
+        }
+
         /** Unique work id */
         const uint32_t WorkId{0};
 
         /** Work method wait handle */
         const std::shared_ptr<AsyncWaitHandle> WaitHandle{nullptr};
+
+    private:
+        /** Not held on to, the work and its captures are released as soon as it has run */
+        std::weak_ptr<Task> _task;
     };
 
+    /** Maximum number of tasks a worker moves from the injection queue onto its own deque at once */
+    static constexpr uint32_t WORK_STEALING_INJECTION_BATCH = 32;
+
     class ThreadPool : public Venus::Module<ThreadPool>, public std::enable_shared_from_this<ThreadPool> {
     public:
         friend TaskScheduler;
 
+        friend PooledThread;
+
         /**
          * Constructor
          * @param description A ThreadPoolDescription instance
@@ -75,9 +150,17 @@ namespace Venus::Utility::Threading {
          * @param threadName The thread name
          * @param work The function to execute
          * @param arguments Arguments to the function
+         * @param cancellation Skips the work if cancelled before it starts, the work may poll it to stop early
          * @return
          */
-        std::shared_ptr<PooledWorkDescription> queueWork(const std::function<void()> &workMethod);
+        std::shared_ptr<PooledWorkDescription> queueWork(const std::function<void()> &workMethod,
+                                                         const CancellationToken &cancellation = {});
+
+        /**
+         * Returns an awaitable that moves the awaiting coroutine onto a pooled thread, use as
+         * `co_await ThreadPool::instance()->schedule()`
+         */
+        Executor::ScheduleAwaitable schedule();
 
         /**
          * Increases the quota for worker threads
@@ -91,6 +174,28 @@ namespace Venus::Utility::Threading {
          */
         void removeWorker();
 
+        /**
+         * Runs a single pending task if the calling thread is a pool worker, used to keep a worker busy while it
+         * waits on other work rather than blocking it
+         * @note When work stealing the task may come from any worker or the injection queue, otherwise only from the
+         * calling worker's own queue
+         * @return False if the calling thread is not a pool worker or there was no work to run
+         */
+        static bool runPendingWork();
+
+        /** Returns true if the calling thread is one of the workers of a thread pool */
+        static bool isWorkerThread();
+
+        /**
+         * Hands a fiber made ready by the task the calling worker is running to that worker, which resumes it
+         * straight after the task rather than queuing it
+         * @return False if the calling thread is not signalling a task or has already been handed a fiber
+         */
+        static bool resumeAfterCurrentTask(Fiber *fiber);
+
+        /** Returns the current quota for worker threads, the number of workers the pool runs at most */
+        uint32_t getWorkerQuota() const;
+
         /**
          * Signals the thread pool to shut, and kill all workers
          * @note blocking call, will try too join all workers
@@ -98,28 +203,23 @@ namespace Venus::Utility::Threading {
         void shutdown() override;
 
         /** Destructor */
-        ~ThreadPool() override = default;
+        ~ThreadPool() override;
 
     private:
         /**
          * Adds a task from the scheduler to be executed by a thread in the pool
-         * @param task The task
+         * @param task The task, whose dependencies have all completed
+         * @note Cancelled tasks are queued all the same, the worker reaching them skips their work and signals them
          */
         void _addScheduledWork(const std::shared_ptr<Task> &task);
 
-        /**
-         * Queues a new task to the thread and sorts the threads queue
-         * @param task The task to be queued
-         * @param worker The pooled thread worker
-         */
-        static void _queueTaskAndSort(const std::shared_ptr<PooledThread> &worker, const std::shared_ptr<Task> &task);
-
         /**
          * Queues a work method and adds it to the queue
          * @param workMethod Work Method
          * @param workId The unique work identifier
          */
-        static std::shared_ptr<Task> _createTaskFromWorkMethod(const std::function<void()> &workMethod, uint32_t workId);
+        static std::shared_ptr<Task> _createTaskFromWorkMethod(const std::function<void()> &workMethod, uint32_t workId,
+                                                               const CancellationToken &cancellation);
 
         /**
          * Retrieves the first free thread, if one is not found a new one is create if the max quota has not been
@@ -135,19 +235,11 @@ namespace Venus::Utility::Threading {
         void _removeLeastBusyTempWorker();
 
         /**
-         * Removes a single temporary worker from the pool
-         * @note Least busy thread will steal the work of the thread killed
+         * Removes temporary workers from the pool
+         * @note Only idle temporary workers are removed, and only when work stealing is enabled
          */
         void _removeOneWorker();
 
-        /**
-         * Initiates a work stealing process.
-         * @note Least busy worker steals all work from busiest,
-         * busiest worker will have no work after method has executed
-         * @return The id of the victim thread,
-         */
-        uint32_t _leastBusyStealWork();
-
         /**
          * Creates a new pooled worker and returns them
          * @return The pooled worker
@@ -179,28 +271,133 @@ namespace Venus::Utility::Threading {
         uint32_t _getWorkerCount() const;
 
         /**
-         * Removes the temporary worker the given Id
-         * @param workerId The worker id
+         * Removes all temporary workers marked as destroyed
          */
-        void _removeTempWorkerById(uint32_t workerId);
+        void _removeTempWorkerIfDestroyed();
 
         /**
-         * Removes all temporary workers marked as destroyed
+         * Queues the task on the calling worker's deque, or on the injection queue if called from outside the pool,
+         * and wakes an idle worker to run it
+         * @param task The task to be queued
          */
-        void _removeTempWorkerIfDestroyed();
+        void _submitStealableWork(const std::shared_ptr<Task> &task);
+
+        /**
+         * Drops the work still queued on the workers' deques and the injection queue, a task on a deque holds the only
+         * reference to itself
+         * @note Called once the workers have been joined
+         */
+        void _releaseQueuedWork();
+
+        /** Creates a new stealing worker if the pool is below its quota */
+        void _ensureStealingWorker();
+
+        /**
+         * Finds work for an idle worker, first from the injection queue then by stealing from another worker
+         * @param worker The worker looking for work
+         * @return The task to execute, nullptr if none was found
+         */
+        std::shared_ptr<Task> _findWork(PooledThread &worker);
+
+        /**
+         * Takes a task from the injection queue, moving a batch of the tasks behind it onto the worker's deque
+         * @param worker The worker taking the task
+         * @return The task to execute, nullptr if the injection queue is empty
+         */
+        std::shared_ptr<Task> _takeInjectedWork(PooledThread &worker);
+
+        /**
+         * Steals half of the work of the first non empty worker, starting from a random victim
+         * @note Workers in the thief's domain are tried before those in any other
+         * @param thief The worker stealing, stolen work beyond the returned task is pushed onto its deque
+         * @return The task to execute, nullptr if there was nothing to steal
+         */
+        std::shared_ptr<Task> _stealWork(PooledThread &thief);
+
+        /** Returns true if the injection queue or any worker's deque has work */
+        bool _hasStealableWork();
+
+        /**
+         * Lists the worker as idle and blocks it until it is woken
+         * @note The queues are checked again once the worker is listed, so work published in between is not missed
+         */
+        void _parkWorker(PooledThread &worker);
+
+        /** Wakes a single idle worker, if any and no other worker is already searching for work */
+        void _wakeIdleWorker();
+
+        /**
+         * Removes the worker from the idle list
+         * @return False if the worker was not listed, meaning it has already been handed a wake
+         */
+        bool _removeIdleWorker(PooledThread *worker);
+
+        /** Publishes the current workers as steal victims, caller must hold _mutex */
+        void _publishStealVictims();
+
+        /**
+         * Returns where the worker at the given index runs, the index wrapping around once every CPU has a worker
+         * @note Workers are dealt out to the domains in turn, so a pool smaller than the machine is spread over it
+         */
+        WorkerPlacement _getWorkerPlacement(uint32_t workerIndex) const;
+
+        /** Loop of the elastic controller's thread, sampling the workers until the pool shuts down */
+        void _runElasticController();
+
+        /** Samples the workers' utilisation and queued work, growing or shrinking the pool once the load has held */
+        void _sampleElasticLoad();
+
+        /** Stops and joins the elastic controller's thread, if it is running */
+        void _stopElasticController();
+
+        /** Adds a temporary worker to the quota */
+        void _growElastic();
+
+        /**
+         * Removes a temporary worker from the quota, destroying an idle one if the worker was created
+         * @return False if every temporary worker is busy
+         */
+        bool _shrinkElastic();
 
         std::vector<std::shared_ptr<PooledThread>> _pooledThreads;
         std::vector<std::shared_ptr<PooledThread>> _tempPooledThreads;
 
         Mutex _mutex{};
 
-        uint32_t _quota{0};
+        std::atomic_uint32_t _quota{0};
         ThreadPoolDescription _description;
 
         bool _enableWorkStealing{false};
         std::atomic_uint32_t _threadIds{0};
 
+        /** The CPUs of each domain, empty when the workers are not pinned */
+        std::vector<std::vector<uint32_t>> _domains;
+
         std::atomic_uint32_t _workerAge{0};
+
+        /** Work stealing state, unused when work stealing is disabled */
+        DataStructures::PriorityBucketQueue<std::shared_ptr<Task>, TASK_PRIORITY_LEVELS> _injectionQueue;
+        Mutex _injectionMutex;
+        std::atomic_uint32_t _injectedWork{0};
+
+        std::atomic<std::shared_ptr<const std::vector<std::shared_ptr<PooledThread>>>> _stealVictims;
+        std::atomic_uint32_t _workerCount{0};
+        std::atomic_uint32_t _workIds{0};
+
+        /** Elastic controller state, the samples are only touched by the controller's thread */
+        std::thread *_elasticController{nullptr};
+        Mutex _elasticMutex;
+        Signal _elasticSignal;
+        bool _stopElastic{false};
+        uint32_t _elasticWorkers{0};
+        uint32_t _growSamples{0};
+        uint32_t _shrinkSamples{0};
+        std::chrono::steady_clock::time_point _lastElasticSample{};
+
+        std::vector<PooledThread *> _idleWorkers;
+        Mutex _idleMutex;
+        std::atomic_uint32_t _idleWorkerCount{0};
+        std::atomic_uint32_t _searchingWorkers{0};
     };
 }
 
@@ -45,9 +45,22 @@ using Map = std::map<Key, Value>;
 /** The engine's worker thread name prefix */
 #define WORKER_THREAD_NAME_PREFIX "Venus::WORKERTHREAD::"
 
+/** The engine's I/O thread name prefix */
+#define IO_THREAD_NAME_PREFIX "Venus::IOTHREAD::"
+
 /** Returns the number of logical CPU cores. */
 #define THREAD_HARDWARE_CONCURRENCY std::thread::hardware_concurrency()
 
+/** Hints to the CPU that the calling thread is in a spin-wait loop. */
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define THREAD_CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define THREAD_CPU_RELAX() asm volatile("yield")
+#else
+#define THREAD_CPU_RELAX()
+#endif
+
 
 #if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
 #define SUPPORTS_PTHREAD (unix) || __unix__ || __unix
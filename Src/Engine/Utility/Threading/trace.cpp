@@ -0,0 +1,324 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "trace.h"
+#include "threading.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace Venus::Utility::Threading {
+    namespace {
+        const auto traceEpoch = std::chrono::steady_clock::now();
+
+        /** Category shown for the event type in the trace viewer */
+        const char *getCategory(TraceEventType type) {
+            switch (type) {
+                case TraceEventType::TaskQueued:
+                    return "queue";
+                case TraceEventType::TaskRun:
+                case TraceEventType::TaskCancelled:
+                    return "task";
+                case TraceEventType::TaskStolen:
+                    return "steal";
+                case TraceEventType::Wait:
+                    return "wait";
+                case TraceEventType::CommandPlayback:
+                    return "corethread";
+            }
+
+            return "unknown";
+        }
+
+        /** Name the event type's value is shown under in the trace viewer */
+        const char *getValueName(TraceEventType type) {
+            switch (type) {
+                case TraceEventType::TaskStolen:
+                    return "victim";
+                case TraceEventType::CommandPlayback:
+                    return "commands";
+                default:
+                    return "id";
+            }
+        }
+
+        /** Appends the text as a JSON string */
+        void appendJsonString(std::string &json, std::string_view text) {
+            json += '"';
+
+            for (char character : text) {
+                if (character == '"' || character == '\\') {
+                    json += '\\';
+                    json += character;
+                } else if (static_cast<unsigned char>(character) < 0x20) {
+                    json += fmt::format("\\u{:04x}", static_cast<int>(character));
+                } else {
+                    json += character;
+                }
+            }
+
+            json += '"';
+        }
+    }
+
+    /**
+     * Events are written by the owning thread alone. Each slot carries a sequence, odd while the slot is being
+     * written, so a thread writing out the trace skips a slot overwritten under it rather than reading a torn event.
+     */
+    class TraceThreadBuffer {
+    public:
+        explicit TraceThreadBuffer(uint32_t id)
+                : id(id),
+                  _slots(std::make_unique<Slot[]>(TRACE_BUFFER_CAPACITY)) {}
+
+        /** Appends an event, called by the owning thread only */
+        void push(const TraceEvent &event) {
+            uint64_t index = this->_written.load(std::memory_order_relaxed);
+            Slot &slot = this->_slots[index % TRACE_BUFFER_CAPACITY];
+
+            slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            slot.event = event;
+
+            slot.sequence.store(index * 2 + 2, std::memory_order_release);
+            this->_written.store(index + 1, std::memory_order_release);
+        }
+
+        /** Copies the events still held, oldest first */
+        std::vector<TraceEvent> read() const {
+            uint64_t written = this->_written.load(std::memory_order_acquire);
+            uint64_t first = written > TRACE_BUFFER_CAPACITY ? written - TRACE_BUFFER_CAPACITY : 0;
+
+            std::vector<TraceEvent> events;
+            events.reserve(written - first);
+
+            for (uint64_t index = first; index < written; ++index) {
+                const Slot &slot = this->_slots[index % TRACE_BUFFER_CAPACITY];
+
+                uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence != index * 2 + 2)
+                    continue;
+
+                TraceEvent event;
+                std::memcpy(&event, &slot.event, sizeof(TraceEvent));
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+                    continue;
+
+                events.push_back(event);
+            }
+
+            return events;
+        }
+
+        /** Returns true if no event has been recorded since the buffer was last cleared */
+        bool isEmpty() const {
+            return this->_written.load(std::memory_order_acquire) == 0;
+        }
+
+        /** Drops the events held, called with the registry locked */
+        void clear() {
+            // Leaves the sequences be, they only ever match the index that last wrote the slot
+            this->_written.store(0, std::memory_order_release);
+        }
+
+        /** Number of the buffer, the thread id shown in the trace */
+        const uint32_t id;
+
+        /** Name of the thread owning the buffer, guarded by the registry mutex */
+        std::string threadName;
+
+        /** Set once the owning thread has exited, guarded by the registry mutex */
+        bool retired{false};
+
+        /**
+         * Set once the events of a retired buffer have been written out or cleared, only then is it handed to a new
+         * thread. Guarded by the registry mutex.
+         */
+        bool drained{false};
+
+    private:
+        struct Slot {
+            std::atomic_uint64_t sequence{0};
+            TraceEvent event;
+        };
+
+        std::unique_ptr<Slot[]> _slots;
+        std::atomic_uint64_t _written{0};
+    };
+
+    namespace {
+        /** Buffers of every thread that has recorded an event, kept once a thread exits so its events can be written */
+        struct TraceRegistry {
+            Mutex mutex;
+            std::vector<std::unique_ptr<TraceThreadBuffer>> buffers;
+        };
+
+        TraceRegistry &getRegistry() {
+            // Never destroyed, threads may still record events as the process exits
+            static auto *registry = new TraceRegistry();
+            return *registry;
+        }
+
+        /** Retires the thread's buffer as the thread exits */
+        struct ThreadBufferOwner {
+            TraceThreadBuffer *buffer{nullptr};
+
+            /** Name given before the thread recorded its first event, picked up by the buffer once it is taken */
+            std::string pendingName;
+
+            ~ThreadBufferOwner() {
+                if (this->buffer == nullptr)
+                    return;
+
+                Lock lock(getRegistry().mutex);
+                this->buffer->retired = true;
+                this->buffer->drained = this->buffer->isEmpty();
+            }
+        };
+
+        thread_local ThreadBufferOwner threadBufferOwner;
+    }
+
+    void Tracer::setEnabled(bool enabled) {
+        Tracer::_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    uint64_t Tracer::now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - traceEpoch).count());
+    }
+
+    void Tracer::setThreadName(std::string_view name) {
+        // Buffers are only taken once a thread records, threads never traced cost nothing
+        if (threadBufferOwner.buffer == nullptr) {
+            threadBufferOwner.pendingName = name;
+            return;
+        }
+
+        Lock lock(getRegistry().mutex);
+        threadBufferOwner.buffer->threadName = name;
+    }
+
+    bool Tracer::writeChromeTrace(const std::string &path) {
+        std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+
+        auto separate = [&json, &first]() {
+            if (!first)
+                json += ",\n";
+
+            first = false;
+        };
+
+        TraceRegistry &registry = getRegistry();
+        Lock lock(registry.mutex);
+
+        for (const auto &buffer : registry.buffers) {
+            // The owner of a retired buffer has exited, once written out its events may make way for a new thread's
+            if (buffer->retired)
+                buffer->drained = true;
+
+            std::string threadName = buffer->threadName.empty()
+                                     ? fmt::format("Thread {}", buffer->id)
+                                     : buffer->threadName;
+
+            separate();
+            json += fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":)", buffer->id);
+            appendJsonString(json, threadName);
+            json += "}}";
+
+            for (const auto &event : buffer->read()) {
+                separate();
+                json += "{\"name\":";
+                appendJsonString(json, event.name);
+
+                // Chrome traces are in microseconds, fractions keep the nanoseconds
+                json += fmt::format(R"(,"cat":"{}","pid":1,"tid":{},"ts":{:.3f})", getCategory(event.type),
+                                    buffer->id, static_cast<double>(event.start) / 1000.0);
+
+                if (event.duration == 0)
+                    json += R"(,"ph":"i","s":"t")";
+                else
+                    json += fmt::format(R"(,"ph":"X","dur":{:.3f})", static_cast<double>(event.duration) / 1000.0);
+
+                json += fmt::format(R"(,"args":{{"{}":{}}}}})", getValueName(event.type), event.value);
+            }
+        }
+
+        lock.unlock();
+        json += "]}\n";
+
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        if (!file)
+            return false;
+
+        file << json;
+        return static_cast<bool>(file);
+    }
+
+    void Tracer::clear() {
+        TraceRegistry &registry = getRegistry();
+        Lock lock(registry.mutex);
+
+        for (const auto &buffer : registry.buffers) {
+            buffer->clear();
+
+            if (buffer->retired)
+                buffer->drained = true;
+        }
+    }
+
+    TraceThreadBuffer &Tracer::_getThreadBuffer() {
+        if (threadBufferOwner.buffer != nullptr)
+            return *threadBufferOwner.buffer;
+
+        TraceRegistry &registry = getRegistry();
+        Lock lock(registry.mutex);
+
+        // Threads come and go with the elastic pool, a buffer left by a thread that has exited is reused once its
+        // events have been written out, until then it is kept and the new thread gets a buffer of its own
+        auto retired = std::find_if(registry.buffers.begin(), registry.buffers.end(),
+                                    [](const auto &buffer) { return buffer->retired && buffer->drained; });
+
+        if (retired != registry.buffers.end()) {
+            (*retired)->retired = false;
+            (*retired)->drained = false;
+            (*retired)->clear();
+
+            threadBufferOwner.buffer = retired->get();
+        } else {
+            auto id = static_cast<uint32_t>(registry.buffers.size() + 1);
+            registry.buffers.push_back(std::make_unique<TraceThreadBuffer>(id));
+
+            threadBufferOwner.buffer = registry.buffers.back().get();
+        }
+
+        threadBufferOwner.buffer->threadName = std::move(threadBufferOwner.pendingName);
+
+        return *threadBufferOwner.buffer;
+    }
+
+    void Tracer::_write(TraceEventType type, std::string_view name, uint64_t value, uint64_t start,
+                        uint64_t duration) {
+        TraceEvent event;
+        event.start = start;
+        event.duration = duration;
+        event.value = value;
+        event.type = type;
+
+        size_t length = std::min<size_t>(name.size(), TRACE_NAME_LENGTH);
+        std::memcpy(event.name, name.data(), length);
+        event.name[length] = '\0';
+
+        Tracer::_getThreadBuffer().push(event);
+    }
+}
@@ -0,0 +1,159 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_TRACE_H
+#define VENUS_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Venus::Utility::Threading {
+    /** Number of events each thread keeps, once full the oldest are overwritten */
+    static constexpr uint32_t TRACE_BUFFER_CAPACITY = 1 << 14;
+
+    /** Environment variable naming the file the engine writes a trace of the whole run to, tracing is off if unset */
+#define TRACE_FILE_VARIABLE "VENUS_TRACE_FILE"
+
+    /** Longest name kept with an event, longer names are cut short */
+    static constexpr uint32_t TRACE_NAME_LENGTH = 31;
+
+    /** What a trace event records */
+    enum class TraceEventType : uint8_t {
+        /** A task was queued on a worker or the injection queue, the value is its id */
+        TaskQueued,
+        /** A task ran, the value is its id */
+        TaskRun,
+        /** A worker skipped a cancelled task, the value is its id */
+        TaskCancelled,
+        /** A worker stole a task, the value is the worker it was stolen from */
+        TaskStolen,
+        /** A thread waited on a wait handle */
+        Wait,
+        /** The core thread played back queued commands, the value is the number of commands */
+        CommandPlayback
+    };
+
+    /** A single recorded event, times are in nanoseconds since tracing was first used */
+    struct TraceEvent {
+        uint64_t start{0};
+
+        /** 0 for an instant event */
+        uint64_t duration{0};
+
+        uint64_t value{0};
+        TraceEventType type{TraceEventType::TaskRun};
+
+        char name[TRACE_NAME_LENGTH + 1]{};
+    };
+
+    /** The ring buffer of a single thread */
+    class TraceThreadBuffer;
+
+    /**
+     * Records what the task system runs into per thread ring buffers, and writes them out as a Chrome trace.
+     *
+     * Always compiled in and off until enabled, a disabled tracer costs a relaxed load per event. Each thread writes
+     * to a buffer of its own without locks or allocations, so tracing can be left on in production and dumped when
+     * a hitch is seen. The trace loads in chrome://tracing and in Perfetto.
+     *
+     * @note Thread safe, events recorded while a trace is being written may or may not be part of it
+     */
+    class Tracer {
+    public:
+        /** Turns recording on or off, events already recorded are kept */
+        static void setEnabled(bool enabled);
+
+        /** Returns true if events are being recorded */
+        static bool isEnabled() {
+            return Tracer::_enabled.load(std::memory_order_relaxed);
+        }
+
+        /** Returns the current trace time in nanoseconds */
+        static uint64_t now();
+
+        /**
+         * Records an event on the calling thread's buffer, if tracing is enabled
+         * @param start The trace time the event started at
+         * @param duration How long the event took, 0 for an instant event
+         */
+        static void record(TraceEventType type, std::string_view name, uint64_t value, uint64_t start,
+                           uint64_t duration) {
+            if (Tracer::isEnabled())
+                Tracer::_write(type, name, value, start, duration);
+        }
+
+        /** Records an instant event at the current time, if tracing is enabled */
+        static void instant(TraceEventType type, std::string_view name, uint64_t value) {
+            if (Tracer::isEnabled())
+                Tracer::_write(type, name, value, Tracer::now(), 0);
+        }
+
+        /**
+         * Names the calling thread in the trace, threads left unnamed are listed by number
+         * @note Does not take a buffer, a thread's buffer is only allocated once it records an event
+         */
+        static void setThreadName(std::string_view name);
+
+        /**
+         * Writes the events of every thread to a file in the Chrome trace event format
+         * @return False if the file could not be written
+         */
+        static bool writeChromeTrace(const std::string &path);
+
+        /**
+         * Drops every event recorded so far
+         * @note An event being recorded as the buffers are cleared may be kept
+         */
+        static void clear();
+
+    private:
+        /** Returns the calling thread's buffer, taking one on the thread's first event */
+        static TraceThreadBuffer &_getThreadBuffer();
+
+        static void _write(TraceEventType type, std::string_view name, uint64_t value, uint64_t start,
+                           uint64_t duration);
+
+        static inline std::atomic_bool _enabled{false};
+    };
+
+    /**
+     * Records the time from its construction to its destruction as one event
+     * @note The name is copied when the scope ends, it has to outlive the scope
+     */
+    class TraceScope {
+    public:
+        TraceScope(TraceEventType type, std::string_view name, uint64_t value = 0)
+                : _recording(Tracer::isEnabled()),
+                  _start(_recording ? Tracer::now() : 0),
+                  _name(name),
+                  _value(value),
+                  _type(type) {}
+
+        TraceScope(const TraceScope &) = delete;
+
+        TraceScope &operator=(const TraceScope &) = delete;
+
+        /** Replaces the value recorded with the event, e.g. a count known once the scope's work is done */
+        void setValue(uint64_t value) {
+            this->_value = value;
+        }
+
+        ~TraceScope() {
+            // Not recorded if tracing was turned on part way through the scope
+            if (this->_recording)
+                Tracer::record(this->_type, this->_name, this->_value, this->_start, Tracer::now() - this->_start);
+        }
+
+    private:
+        bool _recording;
+        uint64_t _start;
+        std::string_view _name;
+        uint64_t _value;
+        TraceEventType _type;
+    };
+}
+
+#endif //VENUS_TRACE_H
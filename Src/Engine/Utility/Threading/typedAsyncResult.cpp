@@ -0,0 +1,75 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#include "typedAsyncResult.h"
+#include "threadPool.h"
+
+namespace Venus::Utility::Threading {
+    TypedAsyncResultBase::~TypedAsyncResultBase() {
+        Continuation *continuation = this->_continuations.load(std::memory_order_acquire);
+
+        // Continuations of a task that never completed are dropped without running
+        while (continuation != nullptr && continuation != &TypedAsyncResultBase::_completedMarker) {
+            Continuation *next = continuation->next;
+            delete continuation;
+            continuation = next;
+        }
+    }
+
+    void TypedAsyncResultBase::blockUntilComplete() {
+        Continuation *continuations = this->_continuations.load(std::memory_order_acquire);
+        while (continuations != &TypedAsyncResultBase::_completedMarker) {
+            // A pool worker runs other pending work rather than blocking, only once there is none left does it wait
+            if (!ThreadPool::runPendingWork())
+                this->_continuations.wait(continuations, std::memory_order_acquire);
+
+            continuations = this->_continuations.load(std::memory_order_acquire);
+        }
+
+        this->_rethrowIfFailed();
+    }
+
+    void TypedAsyncResultBase::addContinuation(Executor::Work &&continuation, Executor &executor) {
+        if (this->hasCompleted()) {
+            executor.execute(std::move(continuation));
+            return;
+        }
+
+        auto *node = new Continuation{std::move(continuation), &executor, nullptr};
+        Continuation *head = this->_continuations.load(std::memory_order_acquire);
+
+        do {
+            if (head == &TypedAsyncResultBase::_completedMarker) {
+                executor.execute(std::move(node->work));
+                delete node;
+                return;
+            }
+
+            node->next = head;
+        } while (!this->_continuations.compare_exchange_weak(head, node, std::memory_order_release,
+                                                             std::memory_order_acquire));
+    }
+
+    void TypedAsyncResultBase::_markAsComplete() {
+        Continuation *continuation = this->_continuations.exchange(&TypedAsyncResultBase::_completedMarker,
+                                                                   std::memory_order_acq_rel);
+        this->_continuations.notify_all();
+
+        // The list was pushed newest first, reverse it so continuations run in the order they were added
+        Continuation *ordered = nullptr;
+        while (continuation != nullptr) {
+            Continuation *next = continuation->next;
+            continuation->next = ordered;
+            ordered = continuation;
+            continuation = next;
+        }
+
+        while (ordered != nullptr) {
+            Continuation *next = ordered->next;
+            ordered->executor->execute(std::move(ordered->work));
+            delete ordered;
+            ordered = next;
+        }
+    }
+}
@@ -0,0 +1,374 @@
+//
+// Created by Kelvin Macartney on 18/10/2026.
+//
+
+#ifndef VENUS_TYPEDASYNCRESULT_H
+#define VENUS_TYPEDASYNCRESULT_H
+
+#include <Error/venusExceptions.h>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "executor.h"
+
+namespace Venus::Core {
+    class QueuedCommand;
+}
+
+namespace Venus::Utility::Threading {
+    template<typename ReturnType>
+    class TypedAsyncResult;
+
+    template<typename ReturnType>
+    class CoroutineTask;
+
+    class IoExecutor;
+
+    template<typename Results>
+    std::shared_ptr<TypedAsyncResult<void>> whenAll(const Results &results);
+
+    template<typename Results>
+    std::shared_ptr<TypedAsyncResult<size_t>> whenAny(const Results &results);
+
+    /**
+     * Completion state shared by every TypedAsyncResult specialization.
+     *
+     * @note Completion and continuations share a single lock-free list, completing swaps in a marker and runs
+     * whatever was registered before it. A task whose work threw completes as failed, holding the exception.
+     */
+    class TypedAsyncResultBase : public std::enable_shared_from_this<TypedAsyncResultBase> {
+        template<typename>
+        friend class TypedAsyncResult;
+
+        template<typename Results>
+        friend std::shared_ptr<TypedAsyncResult<void>> whenAll(const Results &results);
+
+    public:
+        TypedAsyncResultBase() = default;
+
+        TypedAsyncResultBase(const TypedAsyncResultBase &) = delete;
+
+        TypedAsyncResultBase &operator=(const TypedAsyncResultBase &) = delete;
+
+        ~TypedAsyncResultBase();
+
+        /** Returns true if the task is marked as completed */
+        bool hasCompleted() const {
+            return this->_continuations.load(std::memory_order_acquire) == &TypedAsyncResultBase::_completedMarker;
+        }
+
+        /** Returns true if the task completed with an exception instead of a value */
+        bool hasFailed() const {
+            return this->hasCompleted() && this->_exception != nullptr;
+        }
+
+        /**
+         * Returns the exception the task failed with, nullptr if it completed with a value
+         * @note This is only valid if task has been marked complete
+         */
+        std::exception_ptr getException() const {
+            this->_throwIfNotCompleted();
+
+            return this->_exception;
+        }
+
+        /**
+         * Will block the calling thread until the task is marked as complete
+         * @note Called on a ThreadPool worker the worker runs other pending tasks while it waits
+         * @note Rethrows the exception the task failed with
+         */
+        void blockUntilComplete();
+
+        /**
+         * Runs the continuation through the executor once the task completes
+         * @param continuation The work to run, straight away if the task has already completed
+         * @param executor Where the continuation runs, must outlive the task
+         * @note Continuations run in the order they were added
+         */
+        void addContinuation(Executor::Work &&continuation, Executor &executor);
+
+    protected:
+        /** Marks the task as completed, wakes every blocked thread and runs the continuations */
+        void _markAsComplete();
+
+        /**
+         * Stores the exception and marks the task as completed
+         * @param exception The exception the task's work threw
+         */
+        void _markAsFailed(std::exception_ptr exception) {
+            this->_exception = std::move(exception);
+            this->_markAsComplete();
+        }
+
+        /** Throws if the task has not been marked as completed */
+        void _throwIfNotCompleted() const {
+            if (!this->hasCompleted()) VENUS_EXCEPT(InvalidOperationException,
+                                                    "Task must be completed before getting result");
+        }
+
+        /** Rethrows the exception the task failed with, if any */
+        void _rethrowIfFailed() const {
+            if (this->_exception != nullptr)
+                std::rethrow_exception(this->_exception);
+        }
+
+    private:
+        /** A continuation waiting for the task to complete */
+        struct Continuation {
+            Executor::Work work;
+            Executor *executor;
+            Continuation *next;
+        };
+
+        /** Stored in place of the continuation list once the task has completed */
+        static inline Continuation _completedMarker{};
+
+        std::atomic<Continuation *> _continuations{nullptr};
+
+        /** Written before the task is marked as completed, read once it has */
+        std::exception_ptr _exception{nullptr};
+    };
+
+    /**
+     * Strongly typed result of an asynchronous operation. The value is stored inline, so a result created with
+     * std::make_shared costs a single allocation and the value is never boxed or copied. Move-only types are supported
+     * through takeResult().
+     *
+     * @note Must be owned by a std::shared_ptr for then() to be used
+     */
+    template<typename ReturnType>
+    class TypedAsyncResult : public TypedAsyncResultBase {
+        friend Venus::Core::QueuedCommand;
+
+        template<typename>
+        friend class TypedAsyncResult;
+
+        template<typename>
+        friend class CoroutineTask;
+
+        friend IoExecutor;
+
+        template<typename Results>
+        friend std::shared_ptr<TypedAsyncResult<size_t>> whenAny(const Results &results);
+
+    public:
+        TypedAsyncResult() = default;
+
+        /**
+         * Returns a reference to the value returned by the async operation
+         * @note This is only valid if task has been marked complete, rethrows the exception if it failed
+         */
+        ReturnType &getResult() {
+            this->_throwIfNotCompleted();
+            this->_rethrowIfFailed();
+
+            return *this->_returnedValue;
+        }
+
+        /**
+         * Moves the value returned by the async operation out of the result
+         * @note This is only valid if task has been marked complete, and only once, rethrows the exception if it failed
+         */
+        ReturnType takeResult() {
+            this->_throwIfNotCompleted();
+            this->_rethrowIfFailed();
+
+            return std::move(*this->_returnedValue);
+        }
+
+        /**
+         * Chains a continuation that receives a reference to the returned value once the task completes
+         *
+         * @param continuation Callable taking ReturnType &, it may move the value out
+         * @param executor Where the continuation runs, must outlive the task
+         * @return A result completed with the value returned by the continuation, or failed with the exception the task
+         * or the continuation threw. The continuation is skipped if the task failed.
+         * @note The result is kept alive until the continuation has run
+         */
+        template<typename Continuation>
+        auto then(Continuation &&continuation, Executor &executor) {
+            using NextType = std::invoke_result_t<std::decay_t<Continuation> &, ReturnType &>;
+
+            auto next = std::make_shared<TypedAsyncResult<NextType>>();
+            std::weak_ptr<TypedAsyncResult> weakSelf = std::static_pointer_cast<TypedAsyncResult>(
+                    this->shared_from_this());
+
+            // Only a weak reference is held while the result is pending, a result that never completes would otherwise
+            // own itself through its continuation list. Completion hands a strong one on to the continuation.
+            this->addContinuation([weakSelf, next, &executor,
+                                          continuation = std::forward<Continuation>(continuation)]() mutable {
+                auto self = weakSelf.lock();
+                if (self == nullptr)
+                    return;
+
+                if (self->_exception != nullptr) {
+                    next->_markAsFailed(self->_exception);
+                    return;
+                }
+
+                executor.execute([self = std::move(self), next = std::move(next),
+                                         continuation = std::move(continuation)]() mutable {
+                    next->_completeWith([&]() -> NextType { return continuation(*self->_returnedValue); });
+                });
+            }, InlineExecutor::instance());
+
+            return next;
+        }
+
+    protected:
+        /**
+         * Stores the return value and marks the task as completed
+         * @param returnValue The return value
+         */
+        template<typename Value>
+        void _markAsCompleteWithValue(Value &&returnValue) {
+            this->_returnedValue.emplace(std::forward<Value>(returnValue));
+            this->_markAsComplete();
+        }
+
+        /** Completes the task with the value returned by the callable, or fails it with the exception it threw */
+        template<typename Callable>
+        void _completeWith(Callable &&callable) {
+            try {
+                this->_returnedValue.emplace(callable());
+            } catch (...) {
+                this->_markAsFailed(std::current_exception());
+                return;
+            }
+
+            // Outside the try, an exception thrown by a continuation must not complete the task a second time
+            this->_markAsComplete();
+        }
+
+    private:
+        std::optional<ReturnType> _returnedValue;
+    };
+
+    /** @copydoc TypedAsyncResult */
+    template<>
+    class TypedAsyncResult<void> : public TypedAsyncResultBase {
+        friend Venus::Core::QueuedCommand;
+
+        template<typename>
+        friend class TypedAsyncResult;
+
+        template<typename>
+        friend class CoroutineTask;
+
+    public:
+        TypedAsyncResult() = default;
+
+        /**
+         * Chains a continuation that runs once the task completes
+         *
+         * @param continuation Callable taking no arguments
+         * @param executor Where the continuation runs, must outlive the task
+         * @return A result completed with the value returned by the continuation, or failed with the exception the task
+         * or the continuation threw. The continuation is skipped if the task failed.
+         */
+        template<typename Continuation>
+        auto then(Continuation &&continuation, Executor &executor) {
+            using NextType = std::invoke_result_t<std::decay_t<Continuation> &>;
+
+            auto next = std::make_shared<TypedAsyncResult<NextType>>();
+
+            // Run inline while this task completes, so it is still alive to be checked for an exception
+            this->addContinuation([this, next, &executor,
+                                          continuation = std::forward<Continuation>(continuation)]() mutable {
+                if (this->_exception != nullptr) {
+                    next->_markAsFailed(this->_exception);
+                    return;
+                }
+
+                executor.execute([next = std::move(next), continuation = std::move(continuation)]() mutable {
+                    next->_completeWith(continuation);
+                });
+            }, InlineExecutor::instance());
+
+            return next;
+        }
+
+    protected:
+        /** Runs the callable then marks the task as completed, or fails it with the exception it threw */
+        template<typename Callable>
+        void _completeWith(Callable &&callable) {
+            try {
+                callable();
+            } catch (...) {
+                this->_markAsFailed(std::current_exception());
+                return;
+            }
+
+            this->_markAsComplete();
+        }
+    };
+
+    /**
+     * Returns a result that completes once every result in the range has completed
+     * @param results A range of shared pointers to AsyncResult or TypedAsyncResult instances
+     * @note Fails with the exception of the first TypedAsyncResult to fail, as soon as it does
+     */
+    template<typename Results>
+    std::shared_ptr<TypedAsyncResult<void>> whenAll(const Results &results) {
+        auto all = std::make_shared<TypedAsyncResult<void>>();
+        auto remaining = std::make_shared<std::atomic<size_t>>(std::size(results) + 1);
+        auto finished = std::make_shared<std::atomic<bool>>(false);
+
+        for (const auto &result : results) {
+            const TypedAsyncResultBase *typed = nullptr;
+            if constexpr (std::is_base_of_v<TypedAsyncResultBase, std::decay_t<decltype(*result)>>)
+                typed = result.get();
+
+            // Run inline while the result completes, so the result is still alive to be checked for an exception
+            result->addContinuation([all, remaining, finished, typed]() {
+                if (typed != nullptr && typed->_exception != nullptr) {
+                    if (!finished->exchange(true, std::memory_order_acq_rel))
+                        all->_markAsFailed(typed->_exception);
+                } else if (remaining->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    if (!finished->exchange(true, std::memory_order_acq_rel))
+                        all->_markAsComplete();
+                }
+            }, InlineExecutor::instance());
+        }
+
+        // The extra count stops a result completing mid loop from finishing early, and covers an empty range
+        if (remaining->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (!finished->exchange(true, std::memory_order_acq_rel))
+                all->_markAsComplete();
+        }
+
+        return all;
+    }
+
+    /**
+     * Returns a result that completes once any result in the range has completed
+     * @param results A non empty range of shared pointers to AsyncResult or TypedAsyncResult instances
+     * @return A result holding the index of the first result that completed, a failed result counts as completed and
+     * its exception is left for the caller to take from it
+     */
+    template<typename Results>
+    std::shared_ptr<TypedAsyncResult<size_t>> whenAny(const Results &results) {
+        if (std::size(results) == 0) VENUS_EXCEPT(InvalidOperationException, "whenAny requires at least one result.")
+
+        auto any = std::make_shared<TypedAsyncResult<size_t>>();
+        auto claimed = std::make_shared<std::atomic<bool>>(false);
+
+        size_t index = 0;
+        for (const auto &result : results) {
+            result->addContinuation([any, claimed, index]() {
+                if (!claimed->exchange(true, std::memory_order_acq_rel))
+                    any->_markAsCompleteWithValue(index);
+            }, InlineExecutor::instance());
+
+            ++index;
+        }
+
+        return any;
+    }
+}
+
+#endif //VENUS_TYPEDASYNCRESULT_H
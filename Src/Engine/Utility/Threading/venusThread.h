@@ -8,6 +8,7 @@
 #include <thread>
 #include <iostream>
 #include <cstring>
+#include <vector>
 #include <spdlog/spdlog.h>
 #include <Error/venusExceptions.h>
 
@@ -60,6 +61,37 @@ namespace Venus::Utility::Threading {
             setPThreadPriority(thread, policy.Policy, policy.Priority);
         }
 
+        /**
+         * Restricts the thread to the given logical CPUs
+         * @param cpus The CPU ids, an empty list leaves the thread free to run anywhere
+         * @return False if the affinity could not be set, such as when the CPUs are outside the process' cpuset
+         * @note Only supported on Linux, elsewhere the thread is left free to run anywhere
+         */
+        static bool setAffinity(pthread_t &thread, const std::vector<uint32_t> &cpus) {
+#if defined(__linux__)
+            if (cpus.empty())
+                return true;
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+
+            for (uint32_t cpu : cpus) {
+                if (cpu < CPU_SETSIZE)
+                    CPU_SET(cpu, &set);
+            }
+
+            int result = pthread_setaffinity_np(thread, sizeof(set), &set);
+            if (result != 0) {
+                spdlog::warn("Failed to set thread affinity : {}", strerror(result));
+                return false;
+            }
+
+            return true;
+#else
+            return cpus.empty();
+#endif
+        }
+
 #elif _WIN32
 
         /**
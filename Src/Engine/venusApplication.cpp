@@ -10,6 +10,11 @@
 #include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/sinks/daily_file_sink.h>
 #include <Threading/TaskScheduler/taskScheduler.h>
+#include <Threading/ioExecutor.h>
+#include <Threading/trace.h>
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
 #include <Managers/renderWindowManager.h>
 
 
@@ -27,6 +32,7 @@ namespace Venus {
     }
 
     int VenusApplication::Ignition(RenderSurfaceType applicationType) {
+        this->_surfaceType = applicationType;
         _createLogger();
 
         Core::CoreThread::ignite();
@@ -45,24 +51,42 @@ namespace Venus {
 #ifdef __APPLE__
         pthread_setname_np(APPLICATION_THREAD_NAME);
 #endif
+        Utility::Threading::Tracer::setThreadName(APPLICATION_THREAD_NAME);
+
         Venus::Core::System::ignite(); // System
         Utility::Events::EventDispatcher::ignite(); // EventDispatcher
-        Venus::Core::Managers::RenderWindowManager::ignite(); // RenderWindowManager
-        this->_createMainWindow();
+
+        // Headless applications never touch the windowing system, it fails to initialise without a display
+        if (this->_isRendering()) {
+            Venus::Core::Managers::RenderWindowManager::ignite(); // RenderWindowManager
+            this->_createMainWindow();
+        } else {
+            if (this->_renderApi != nullptr)
+                this->_logger->warn("Render surface ignored, the application is running headless");
+
+            this->_logger->info("Application running headless");
+        }
 
         this->_logger->info("Application initialization complete");
         this->_runMainLoop();
     }
 
     void VenusApplication::multiThreadingInitialisation() {
+        // Traced from the start when a trace file is asked for, the trace is written out on shut down
+        if (std::getenv(TRACE_FILE_VARIABLE) != nullptr)
+            Utility::Threading::Tracer::setEnabled(true);
+
         _initialiseThreadPool(); // ThreadPool
         Module<::Venus::Utility::Threading::TaskScheduler>::ignite(); // TaskScheduler
+        Module<::Venus::Utility::Threading::IoExecutor>::ignite(); // IoExecutor
     }
 
     void VenusApplication::_initialiseThreadPool() {
         auto desc = Utility::Threading::ThreadPoolDescription();
-        desc.absoluteMaximum = THREAD_HARDWARE_CONCURRENCY > 16 ? 16 : THREAD_HARDWARE_CONCURRENCY;
         desc.enableWorkStealing = true;
+        // One worker per CPU, each kept on its NUMA node so its work stays next to the memory it allocated
+        desc.affinity = Utility::Threading::WorkerAffinity::Domain;
+        desc.enableElasticScaling = true;
 
         Module<::Venus::Utility::Threading::ThreadPool>::ignite(desc);
     }
@@ -70,7 +94,7 @@ namespace Venus {
     void VenusApplication::_createLogger() {
         using namespace Venus::Factories::Logging;
         this->_logger = LoggingFactory::CreateLogger(
-                []() -> std::__1::shared_ptr<spdlog::logger> {
+                []() -> std::shared_ptr<spdlog::logger> {
                     std::vector<spdlog::sink_ptr> sinks;
                     sinks.push_back(
                             std::make_shared<spdlog::sinks::daily_file_sink_st>("logs/engine_logs.log", 23, 59));
@@ -104,19 +128,39 @@ namespace Venus {
     void VenusApplication::shutDown() {
         this->_logger->info("Engine shutting down");
 
+        Venus::Core::getCoreThread()->waitForFrames(); // Frames still in flight may reference engine modules
         Venus::Core::System::shutDown(); // System
-        Venus::Core::Managers::RenderWindowManager::shutDown(); // RenderWindowManager
+
+        if (this->_isRendering())
+            Venus::Core::Managers::RenderWindowManager::shutDown(); // RenderWindowManager
+
         Venus::Core::CoreThread::shutDown(); // Core thread
         Utility::Events::EventDispatcher::shutDown(); // EventDispatcher
+        Venus::Utility::Threading::IoExecutor::shutDown(); // IoExecutor
         Venus::Utility::Threading::TaskScheduler::shutDown(); // TaskScheduler
         Venus::Core::ThreadPool::shutDown();
+
+        if (const char *tracePath = std::getenv(TRACE_FILE_VARIABLE)) {
+            if (!Utility::Threading::Tracer::writeChromeTrace(tracePath))
+                this->_logger->warn("Failed to write the trace to {}", tracePath);
+        }
+
         spdlog::shutdown();
 
         this->_time = nullptr;
     }
 
+    void VenusApplication::setTickRate(uint32_t ticksPerSecond) {
+        this->_tickRate.store(ticksPerSecond, std::memory_order_relaxed);
+    }
+
+    void VenusApplication::requestQuit() {
+        this->_quitRequested.store(true, std::memory_order_release);
+    }
+
     void VenusApplication::_runMainLoop() {
         this->beginMainLoop();
+        this->_nextTickTime = std::chrono::steady_clock::now();
 
         while (this->_iterateLoop) {
             this->_applicationTick();
@@ -126,7 +170,9 @@ namespace Venus {
     }
 
     void VenusApplication::_applicationTick() {
-        if (Core::Managers::RenderWindowManager::instance()->shouldQuit()) {
+        bool windowsClosed = this->_isRendering() && Core::Managers::RenderWindowManager::instance()->shouldQuit();
+
+        if (this->_quitRequested.exchange(false, std::memory_order_acquire) || windowsClosed) {
             this->quitRequested();
             return;
         }
@@ -134,9 +180,33 @@ namespace Venus {
         this->_time->_tick();
 
         this->preUpdate();
-        Core::Managers::RenderWindowManager::instance()->update();
+
+        if (this->_isRendering())
+            Core::Managers::RenderWindowManager::instance()->update();
 
         this->postUpdate();
+
+        // Hand the frame to the core thread and start on the next one while it plays back
+        Venus::Core::getCoreThread()->submitFrame();
+
+        this->_waitForNextTick();
+    }
+
+    void VenusApplication::_waitForNextTick() {
+        uint32_t tickRate = this->_tickRate.load(std::memory_order_relaxed);
+        if (tickRate == 0)
+            return;
+
+        auto now = std::chrono::steady_clock::now();
+        auto interval = std::chrono::nanoseconds(std::chrono::seconds(1)) / tickRate;
+
+        // Ticks that ran late are not made up for with a burst, the loop carries on at the rate from now
+        this->_nextTickTime = std::max(this->_nextTickTime + interval, now);
+        std::this_thread::sleep_until(this->_nextTickTime);
+    }
+
+    bool VenusApplication::_isRendering() const {
+        return this->_surfaceType != RenderSurfaceType::Headless;
     }
 
     void VenusApplication::beginMainLoop() {
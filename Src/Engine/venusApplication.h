@@ -5,6 +5,8 @@
 #ifndef VENUS_VENUSAPPLICATION_H
 #define VENUS_VENUSAPPLICATION_H
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <spdlog/sinks/sink.h>
 #include <Utility/Time/vTime.h>
@@ -25,7 +27,13 @@ namespace Venus {
         ViewportMode,
 
         /** The engine will create it's own main window */
-        StandaloneModel
+        StandaloneModel,
+
+        /**
+         * The engine runs without a window or render surface, bringing up the core thread, thread pool, task
+         * scheduler, event dispatcher and io executor only. For machines without a display, e.g. soak tests
+         */
+        Headless
     };
 
     class VenusApplication {
@@ -41,6 +49,19 @@ namespace Venus {
         /** Shuts down the application */
         void shutDown();
 
+        /**
+         * Sets the rate the main loop ticks at
+         * @param ticksPerSecond 0 to tick as fast as the core thread plays frames back, the default
+         * @note Thread safe
+         */
+        void setTickRate(uint32_t ticksPerSecond);
+
+        /**
+         * Asks the main loop to end, quitRequested() is called on the application thread at the start of the next tick
+         * @note Thread safe, with no window to close a headless application is ended this way or by endMainLoop()
+         */
+        void requestQuit();
+
         virtual ~VenusApplication() = default;
 
     protected:
@@ -65,11 +86,26 @@ namespace Venus {
         std::shared_ptr<spdlog::logger> _logger;
 
         std::thread _appThread{};
-        bool _iterateLoop{false};
+        std::atomic_bool _iterateLoop{false};
+        std::atomic_bool _quitRequested{false};
+
+        RenderSurfaceType _surfaceType{RenderSurfaceType::StandaloneModel};
+
+        /** Ticks per second, 0 for uncapped */
+        std::atomic_uint32_t _tickRate{0};
+
+        /** The time the next tick is due at when the tick rate is capped */
+        std::chrono::steady_clock::time_point _nextTickTime{};
 
         /** Function called on every tick by the main loop */
         void _applicationTick();
 
+        /** Sleeps until the next tick is due, returns straight away if the tick rate is uncapped */
+        void _waitForNextTick();
+
+        /** Returns true if the application renders, false when running headless */
+        [[nodiscard]] bool _isRendering() const;
+
         /** Creates a main window for the application */
         void _createMainWindow();
 
@@ -1,7 +1,79 @@
 #include <Engine/venusApplication.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
 
-int main() {
-    Venus::VenusApplication application;
+namespace {
+    /**
+     * Parses a whole decimal count, without a sign or surrounding text
+     * @return False if the value is not a number or is larger than maximum
+     */
+    bool parseCount(const char *value, uint64_t maximum, uint64_t &count) {
+        if (*value < '0' || *value > '9')
+            return false;
 
-    return application.Ignition();
+        char *end = nullptr;
+        errno = 0;
+        unsigned long long parsed = std::strtoull(value, &end, 10);
+
+        if (errno == ERANGE || *end != '\0' || parsed > maximum)
+            return false;
+
+        count = parsed;
+        return true;
+    }
+
+    /** Quits the main loop once it has ticked the given number of times, e.g. to end a headless soak run */
+    class LimitedApplication : public Venus::VenusApplication {
+    public:
+        explicit LimitedApplication(uint64_t tickLimit)
+                : _tickLimit(tickLimit) {}
+
+    protected:
+        void postUpdate() override {
+            if (this->_tickLimit != 0 && ++this->_ticks >= this->_tickLimit)
+                this->requestQuit();
+        }
+
+    private:
+        uint64_t _tickLimit;
+        uint64_t _ticks{0};
+    };
+}
+
+/**
+ * Usage: Venus [--headless] [--tick-rate=N] [--ticks=N]
+ * --headless runs the engine without a window, --tick-rate caps the ticks per second and --ticks quits after as many
+ * ticks, 0 for either leaves it unbounded
+ */
+int main(int argc, char **argv) {
+    auto surfaceType = Venus::RenderSurfaceType::StandaloneModel;
+    uint32_t tickRate = 0;
+    uint64_t tickLimit = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+
+        uint64_t count = 0;
+
+        if (argument == "--headless") {
+            surfaceType = Venus::RenderSurfaceType::Headless;
+        } else if (argument.rfind("--tick-rate=", 0) == 0 &&
+                   parseCount(argument.c_str() + 12, std::numeric_limits<uint32_t>::max(), count)) {
+            tickRate = static_cast<uint32_t>(count);
+        } else if (argument.rfind("--ticks=", 0) == 0 &&
+                   parseCount(argument.c_str() + 8, std::numeric_limits<uint64_t>::max(), count)) {
+            tickLimit = count;
+        } else {
+            std::fprintf(stderr, "Usage: %s [--headless] [--tick-rate=N] [--ticks=N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    LimitedApplication application(tickLimit);
+    application.setTickRate(tickRate);
+
+    return application.Ignition(surfaceType);
 }